@@ -0,0 +1,194 @@
+﻿// Benchmarks.cpp : Measures CppEtfer against Jsonifier on Discord-shaped corpora, and writes the results to stdout as JSON.
+// Pass the number of members in each GUILD_CREATE payload as the first argument, which defaults to 1000.
+//
+
+#include "Corpora.hpp"
+#include <CppEtfer/Transcoder.hpp>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <limits>
+
+#if !defined(CPPETFER_VERSION)
+	#define CPPETFER_VERSION "unknown"
+#endif
+
+#if !defined(JSONIFIER_COMMIT)
+	#define JSONIFIER_COMMIT "unknown"
+#endif
+
+/// @brief The throughput of one operation over one corpus.
+struct bench_result {
+	std::string corpus{};///< The name of the corpus.
+	std::string operation{};///< The name of the operation.
+	uint64_t messages{};///< The number of messages processed per pass.
+	uint64_t bytes{};///< The number of bytes read or written per pass.
+	double seconds{};///< The fastest time taken by one pass.
+};
+
+/// @brief The number of timed repetitions, of which the fastest is kept.
+static constexpr uint64_t repetitionCount{ 7 };
+/// @brief The shortest time that one repetition is allowed to take, so that short passes are repeated often enough to be timed.
+static constexpr double minRepetitionSeconds{ 0.05 };
+
+/// @brief Sink for results that the compiler must not be allowed to discard.
+static volatile uint64_t benchSink{};
+
+/// @brief Time a function, which performs one pass over a corpus.
+/// @param function The function to time.
+/// @return The fastest time taken by one pass, in seconds.
+template<typename function_type> double measure(function_type&& function) {
+	auto start = std::chrono::steady_clock::now();
+	function();
+	const double firstSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const uint64_t passCount  = std::max<uint64_t>(1, static_cast<uint64_t>(minRepetitionSeconds / std::max(firstSeconds, 1e-9)));
+	double bestSeconds{ std::numeric_limits<double>::max() };
+	for (uint64_t x = 0; x < repetitionCount; ++x) {
+		start = std::chrono::steady_clock::now();
+		for (uint64_t y = 0; y < passCount; ++y) {
+			function();
+		}
+		bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(passCount));
+	}
+	return bestSeconds;
+}
+
+/// @brief Build an etf_serializer tree holding the same data as a value, for timing the tree-based serializer.
+/// @param value The value to convert.
+/// @return The tree.
+template<typename value_type> CppEtfer::etf_serializer toSerializer(const value_type& value) {
+	if constexpr (CppEtfer::core_t<value_type>) {
+		CppEtfer::etf_serializer data{ CppEtfer::json_type::object_t };
+		std::apply(
+			[&](const auto&... fields) {
+				((data[fields.name] = toSerializer(value.*fields.memberPtr)), ...);
+			},
+			CppEtfer::core<value_type>::parseValue);
+		return data;
+	} else if constexpr (CppEtfer::has_range<value_type> && !CppEtfer::string_t<value_type>) {
+		CppEtfer::etf_serializer data{ CppEtfer::json_type::array_t };
+		for (auto& valueNew: value) {
+			data.emplaceBack(toSerializer(valueNew));
+		}
+		return data;
+	} else {
+		return CppEtfer::etf_serializer{ value };
+	}
+}
+
+/// @brief Time every operation over one corpus.
+/// @param corpus The name of the corpus.
+/// @param values The payloads of the corpus.
+/// @param results The results to append to.
+template<typename value_type> void benchmarkCorpus(std::string_view corpus, const std::vector<value_type>& values, std::vector<bench_result>& results) {
+	std::vector<std::basic_string<uint8_t>> etfStrings{};
+	std::vector<CppEtfer::etf_serializer> trees{};
+	std::vector<std::string> jsonStrings{};
+	jsonifier::jsonifier_core jsonifier{};
+	uint64_t etfBytes{};
+	uint64_t jsonBytes{};
+	for (auto& value: values) {
+		CppEtfer::etf_serializer::serializeToEtf(value, etfStrings.emplace_back());
+		jsonifier.serializeJson(value, jsonStrings.emplace_back());
+		trees.emplace_back(toSerializer(value));
+		etfBytes += etfStrings.back().size();
+		jsonBytes += jsonStrings.back().size();
+	}
+
+	auto addResult = [&](std::string_view operation, uint64_t bytes, double seconds) {
+		results.emplace_back(bench_result{ std::string{ corpus }, std::string{ operation }, values.size(), bytes, seconds });
+		std::cerr << std::left << std::setw(16) << corpus << std::setw(34) << operation << std::right << std::fixed << std::setprecision(1) << std::setw(10)
+				  << static_cast<double>(bytes) / seconds / 1e6 << " MB/s" << std::setw(12) << seconds * 1e9 / static_cast<double>(values.size())
+				  << " ns/message" << std::endl;
+	};
+
+	CppEtfer::etf_parser parser{};
+	addResult("etf_parser::parseEtfToJson", etfBytes, measure([&] {
+		for (auto& etfString: etfStrings) {
+			benchSink = benchSink + parser.parseEtfToJson(etfString).size();
+		}
+	}));
+
+	value_type parsedValue{};
+	addResult("etf_parser::parseEtfToData", etfBytes, measure([&] {
+		for (auto& etfString: etfStrings) {
+			parser.parseEtfToData(parsedValue, etfString);
+		}
+		benchSink = benchSink + parsedValue.s;
+	}));
+
+	addResult("etf_serializer::serializeToBuffer", etfBytes, measure([&] {
+		for (auto& tree: trees) {
+			benchSink = benchSink + tree.serializeToBuffer().size();
+		}
+	}));
+
+	std::basic_string<uint8_t> etfBuffer{};
+	addResult("etf_serializer::serializeToEtf", etfBytes, measure([&] {
+		for (auto& value: values) {
+			CppEtfer::etf_serializer::serializeToEtf(value, etfBuffer);
+			benchSink = benchSink + etfBuffer.size();
+		}
+	}));
+
+	CppEtfer::uninitialized_buffer<uint8_t> transcodeBuffer{};
+	addResult("transcodeJsonToEtf", jsonBytes, measure([&] {
+		for (auto& jsonString: jsonStrings) {
+			CppEtfer::transcodeJsonToEtf(jsonString, transcodeBuffer);
+			benchSink = benchSink + transcodeBuffer.size();
+		}
+	}));
+
+	addResult("jsonifier::parseJson", jsonBytes, measure([&] {
+		for (auto& jsonString: jsonStrings) {
+			jsonifier.parseJson(parsedValue, jsonString);
+		}
+		benchSink = benchSink + parsedValue.s;
+	}));
+
+	std::string jsonBuffer{};
+	addResult("jsonifier::serializeJson", jsonBytes, measure([&] {
+		for (auto& value: values) {
+			jsonifier.serializeJson(value, jsonBuffer);
+			benchSink = benchSink + jsonBuffer.size();
+		}
+	}));
+}
+
+/// @brief Generate a corpus.
+/// @param count The number of payloads.
+/// @param generator The function that generates the payload with a given index.
+/// @return The payloads.
+template<typename function_type> auto generateCorpus(uint64_t count, function_type&& generator) {
+	std::vector<decltype(generator(uint64_t{}))> values{};
+	for (uint64_t x = 0; x < count; ++x) {
+		values.emplace_back(generator(x));
+	}
+	return values;
+}
+
+int main(int argc, char* argv[]) {
+	const uint64_t memberCount = argc > 1 ? std::stoull(argv[1]) : 1000;
+	std::vector<bench_result> results{};
+	benchmarkCorpus("ready", generateCorpus(16, [](uint64_t index) {
+		return generateReady(index, 100);
+	}),
+		results);
+	benchmarkCorpus("guild_create", generateCorpus(8, [&](uint64_t index) {
+		return generateGuildCreate(index, memberCount);
+	}),
+		results);
+	benchmarkCorpus("message_create", generateCorpus(1024, generateMessageCreate), results);
+	benchmarkCorpus("presence_update", generateCorpus(4096, generatePresenceUpdate), results);
+
+	std::cout << "{\"library\":\"CppEtfer\",\"version\":\"" << CPPETFER_VERSION << "\",\"jsonifier_commit\":\"" << JSONIFIER_COMMIT << "\",\"guild_member_count\":" << memberCount << ",\"results\":[";
+	for (uint64_t x = 0; x < results.size(); ++x) {
+		auto& result = results[x];
+		std::cout << (x > 0 ? "," : "") << "{\"corpus\":\"" << result.corpus << "\",\"operation\":\"" << result.operation << "\",\"messages\":" << result.messages
+				  << ",\"bytes\":" << result.bytes << std::fixed << std::setprecision(3) << ",\"mb_per_s\":" << static_cast<double>(result.bytes) / result.seconds / 1e6
+				  << ",\"ns_per_message\":" << result.seconds * 1e9 / static_cast<double>(result.messages) << "}";
+	}
+	std::cout << "]}" << std::endl;
+	return 0;
+}
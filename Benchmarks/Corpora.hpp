@@ -0,0 +1,479 @@
+﻿// Corpora.hpp : Deterministic generators for Discord-shaped gateway payloads, described to both CppEtfer and Jsonifier.
+// Every generator is a pure function of its arguments, so each run and each version of the library measures the same bytes.
+//
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+#include <jsonifier/Index.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+
+/// @brief A gateway payload, carrying an event of type d_type.
+template<typename d_type> struct Payload {
+	std::string t{};
+	int64_t op{};
+	int64_t s{};
+	d_type d{};
+};
+
+struct User {
+	std::string id{};
+	std::string username{};
+	std::string discriminator{};
+	std::string global_name{};
+	std::string avatar{};
+	uint64_t flags{};
+	bool bot{};
+};
+
+struct UnavailableGuild {
+	std::string id{};
+	bool unavailable{};
+};
+
+struct ReadyData {
+	int64_t v{};
+	User user{};
+	std::vector<UnavailableGuild> guilds{};
+	std::string session_id{};
+	std::string session_type{};
+	std::string resume_gateway_url{};
+	std::array<uint32_t, 2> shard{};
+};
+
+struct Role {
+	std::string id{};
+	std::string name{};
+	uint64_t permissions{};
+	int64_t color{};
+	int64_t position{};
+	bool hoist{};
+	bool managed{};
+	bool mentionable{};
+};
+
+struct Channel {
+	std::string id{};
+	std::string name{};
+	std::string topic{};
+	std::string parent_id{};
+	int64_t type{};
+	int64_t position{};
+	bool nsfw{};
+};
+
+struct Member {
+	User user{};
+	std::string nick{};
+	std::vector<std::string> roles{};
+	std::string joined_at{};
+	bool deaf{};
+	bool mute{};
+};
+
+struct GuildCreateData {
+	std::string id{};
+	std::string name{};
+	std::string icon{};
+	std::string owner_id{};
+	int64_t member_count{};
+	std::vector<Role> roles{};
+	std::vector<Channel> channels{};
+	std::vector<Member> members{};
+};
+
+struct EmbedField {
+	std::string name{};
+	std::string value{};
+	bool inlineValue{};
+};
+
+struct EmbedFooter {
+	std::string text{};
+	std::string icon_url{};
+};
+
+struct Embed {
+	std::string title{};
+	std::string type{};
+	std::string description{};
+	std::string url{};
+	int64_t color{};
+	EmbedFooter footer{};
+	std::vector<EmbedField> fields{};
+};
+
+struct MessageData {
+	std::string id{};
+	std::string channel_id{};
+	std::string guild_id{};
+	std::string content{};
+	std::string timestamp{};
+	User author{};
+	std::vector<User> mentions{};
+	std::vector<Embed> embeds{};
+	bool tts{};
+	bool pinned{};
+};
+
+struct Activity {
+	std::string name{};
+	std::string state{};
+	int64_t type{};
+	int64_t created_at{};
+};
+
+struct ClientStatus {
+	std::string desktop{};
+	std::string mobile{};
+};
+
+struct PresenceUser {
+	std::string id{};
+};
+
+struct PresenceData {
+	PresenceUser user{};
+	std::string guild_id{};
+	std::string status{};
+	std::vector<Activity> activities{};
+	ClientStatus client_status{};
+};
+
+template<typename d_type> struct CppEtfer::core<Payload<d_type>> {
+	using value_type				 = Payload<d_type>;
+	static constexpr auto parseValue = createObject("t", &value_type::t, "op", &value_type::op, "s", &value_type::s, "d", &value_type::d);
+};
+
+template<> struct CppEtfer::core<User> {
+	using value_type				 = User;
+	static constexpr auto parseValue = createObject("id", &value_type::id, "username", &value_type::username, "discriminator", &value_type::discriminator, "global_name",
+		&value_type::global_name, "avatar", &value_type::avatar, "flags", &value_type::flags, "bot", &value_type::bot);
+};
+
+template<> struct CppEtfer::core<UnavailableGuild> {
+	using value_type				 = UnavailableGuild;
+	static constexpr auto parseValue = createObject("id", &value_type::id, "unavailable", &value_type::unavailable);
+};
+
+template<> struct CppEtfer::core<ReadyData> {
+	using value_type				 = ReadyData;
+	static constexpr auto parseValue = createObject("v", &value_type::v, "user", &value_type::user, "guilds", &value_type::guilds, "session_id", &value_type::session_id,
+		"session_type", &value_type::session_type, "resume_gateway_url", &value_type::resume_gateway_url, "shard", &value_type::shard);
+};
+
+template<> struct CppEtfer::core<Role> {
+	using value_type				 = Role;
+	static constexpr auto parseValue = createObject("id", &value_type::id, "name", &value_type::name, "permissions", &value_type::permissions, "color", &value_type::color,
+		"position", &value_type::position, "hoist", &value_type::hoist, "managed", &value_type::managed, "mentionable", &value_type::mentionable);
+};
+
+template<> struct CppEtfer::core<Channel> {
+	using value_type				 = Channel;
+	static constexpr auto parseValue = createObject("id", &value_type::id, "name", &value_type::name, "topic", &value_type::topic, "parent_id", &value_type::parent_id, "type",
+		&value_type::type, "position", &value_type::position, "nsfw", &value_type::nsfw);
+};
+
+template<> struct CppEtfer::core<Member> {
+	using value_type				 = Member;
+	static constexpr auto parseValue = createObject("user", &value_type::user, "nick", &value_type::nick, "roles", &value_type::roles, "joined_at", &value_type::joined_at,
+		"deaf", &value_type::deaf, "mute", &value_type::mute);
+};
+
+template<> struct CppEtfer::core<GuildCreateData> {
+	using value_type				 = GuildCreateData;
+	static constexpr auto parseValue = createObject("id", &value_type::id, "name", &value_type::name, "icon", &value_type::icon, "owner_id", &value_type::owner_id,
+		"member_count", &value_type::member_count, "roles", &value_type::roles, "channels", &value_type::channels, "members", &value_type::members);
+};
+
+template<> struct CppEtfer::core<EmbedField> {
+	using value_type				 = EmbedField;
+	static constexpr auto parseValue = createObject("name", &value_type::name, "value", &value_type::value, "inline", &value_type::inlineValue);
+};
+
+template<> struct CppEtfer::core<EmbedFooter> {
+	using value_type				 = EmbedFooter;
+	static constexpr auto parseValue = createObject("text", &value_type::text, "icon_url", &value_type::icon_url);
+};
+
+template<> struct CppEtfer::core<Embed> {
+	using value_type				 = Embed;
+	static constexpr auto parseValue = createObject("title", &value_type::title, "type", &value_type::type, "description", &value_type::description, "url", &value_type::url,
+		"color", &value_type::color, "footer", &value_type::footer, "fields", &value_type::fields);
+};
+
+template<> struct CppEtfer::core<MessageData> {
+	using value_type				 = MessageData;
+	static constexpr auto parseValue = createObject("id", &value_type::id, "channel_id", &value_type::channel_id, "guild_id", &value_type::guild_id, "content",
+		&value_type::content, "timestamp", &value_type::timestamp, "author", &value_type::author, "mentions", &value_type::mentions, "embeds", &value_type::embeds, "tts",
+		&value_type::tts, "pinned", &value_type::pinned);
+};
+
+template<> struct CppEtfer::core<Activity> {
+	using value_type				 = Activity;
+	static constexpr auto parseValue = createObject("name", &value_type::name, "state", &value_type::state, "type", &value_type::type, "created_at", &value_type::created_at);
+};
+
+template<> struct CppEtfer::core<ClientStatus> {
+	using value_type				 = ClientStatus;
+	static constexpr auto parseValue = createObject("desktop", &value_type::desktop, "mobile", &value_type::mobile);
+};
+
+template<> struct CppEtfer::core<PresenceUser> {
+	using value_type				 = PresenceUser;
+	static constexpr auto parseValue = createObject("id", &value_type::id);
+};
+
+template<> struct CppEtfer::core<PresenceData> {
+	using value_type				 = PresenceData;
+	static constexpr auto parseValue = createObject("user", &value_type::user, "guild_id", &value_type::guild_id, "status", &value_type::status, "activities",
+		&value_type::activities, "client_status", &value_type::client_status);
+};
+
+template<typename d_type> struct jsonifier::core<Payload<d_type>> {
+	using ValueType					 = Payload<d_type>;
+	static constexpr auto parseValue = createObject("t", &ValueType::t, "op", &ValueType::op, "s", &ValueType::s, "d", &ValueType::d);
+};
+
+template<> struct jsonifier::core<User> {
+	using ValueType					 = User;
+	static constexpr auto parseValue = createObject("id", &ValueType::id, "username", &ValueType::username, "discriminator", &ValueType::discriminator, "global_name",
+		&ValueType::global_name, "avatar", &ValueType::avatar, "flags", &ValueType::flags, "bot", &ValueType::bot);
+};
+
+template<> struct jsonifier::core<UnavailableGuild> {
+	using ValueType					 = UnavailableGuild;
+	static constexpr auto parseValue = createObject("id", &ValueType::id, "unavailable", &ValueType::unavailable);
+};
+
+template<> struct jsonifier::core<ReadyData> {
+	using ValueType					 = ReadyData;
+	static constexpr auto parseValue = createObject("v", &ValueType::v, "user", &ValueType::user, "guilds", &ValueType::guilds, "session_id", &ValueType::session_id,
+		"session_type", &ValueType::session_type, "resume_gateway_url", &ValueType::resume_gateway_url, "shard", &ValueType::shard);
+};
+
+template<> struct jsonifier::core<Role> {
+	using ValueType					 = Role;
+	static constexpr auto parseValue = createObject("id", &ValueType::id, "name", &ValueType::name, "permissions", &ValueType::permissions, "color", &ValueType::color,
+		"position", &ValueType::position, "hoist", &ValueType::hoist, "managed", &ValueType::managed, "mentionable", &ValueType::mentionable);
+};
+
+template<> struct jsonifier::core<Channel> {
+	using ValueType					 = Channel;
+	static constexpr auto parseValue = createObject("id", &ValueType::id, "name", &ValueType::name, "topic", &ValueType::topic, "parent_id", &ValueType::parent_id, "type",
+		&ValueType::type, "position", &ValueType::position, "nsfw", &ValueType::nsfw);
+};
+
+template<> struct jsonifier::core<Member> {
+	using ValueType					 = Member;
+	static constexpr auto parseValue = createObject("user", &ValueType::user, "nick", &ValueType::nick, "roles", &ValueType::roles, "joined_at", &ValueType::joined_at, "deaf",
+		&ValueType::deaf, "mute", &ValueType::mute);
+};
+
+template<> struct jsonifier::core<GuildCreateData> {
+	using ValueType					 = GuildCreateData;
+	static constexpr auto parseValue = createObject("id", &ValueType::id, "name", &ValueType::name, "icon", &ValueType::icon, "owner_id", &ValueType::owner_id, "member_count",
+		&ValueType::member_count, "roles", &ValueType::roles, "channels", &ValueType::channels, "members", &ValueType::members);
+};
+
+template<> struct jsonifier::core<EmbedField> {
+	using ValueType					 = EmbedField;
+	static constexpr auto parseValue = createObject("name", &ValueType::name, "value", &ValueType::value, "inline", &ValueType::inlineValue);
+};
+
+template<> struct jsonifier::core<EmbedFooter> {
+	using ValueType					 = EmbedFooter;
+	static constexpr auto parseValue = createObject("text", &ValueType::text, "icon_url", &ValueType::icon_url);
+};
+
+template<> struct jsonifier::core<Embed> {
+	using ValueType					 = Embed;
+	static constexpr auto parseValue = createObject("title", &ValueType::title, "type", &ValueType::type, "description", &ValueType::description, "url", &ValueType::url,
+		"color", &ValueType::color, "footer", &ValueType::footer, "fields", &ValueType::fields);
+};
+
+template<> struct jsonifier::core<MessageData> {
+	using ValueType					 = MessageData;
+	static constexpr auto parseValue = createObject("id", &ValueType::id, "channel_id", &ValueType::channel_id, "guild_id", &ValueType::guild_id, "content",
+		&ValueType::content, "timestamp", &ValueType::timestamp, "author", &ValueType::author, "mentions", &ValueType::mentions, "embeds", &ValueType::embeds, "tts",
+		&ValueType::tts, "pinned", &ValueType::pinned);
+};
+
+template<> struct jsonifier::core<Activity> {
+	using ValueType					 = Activity;
+	static constexpr auto parseValue = createObject("name", &ValueType::name, "state", &ValueType::state, "type", &ValueType::type, "created_at", &ValueType::created_at);
+};
+
+template<> struct jsonifier::core<ClientStatus> {
+	using ValueType					 = ClientStatus;
+	static constexpr auto parseValue = createObject("desktop", &ValueType::desktop, "mobile", &ValueType::mobile);
+};
+
+template<> struct jsonifier::core<PresenceUser> {
+	using ValueType					 = PresenceUser;
+	static constexpr auto parseValue = createObject("id", &ValueType::id);
+};
+
+template<> struct jsonifier::core<PresenceData> {
+	using ValueType					 = PresenceData;
+	static constexpr auto parseValue = createObject("user", &ValueType::user, "guild_id", &ValueType::guild_id, "status", &ValueType::status, "activities",
+		&ValueType::activities, "client_status", &ValueType::client_status);
+};
+
+/// @brief A splitmix64 generator, so that the corpora are identical on every platform and standard library.
+struct corpus_random {
+	uint64_t state{};
+
+	inline uint64_t next() {
+		uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+		value		   = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value		   = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+
+	inline uint64_t next(uint64_t bound) {
+		return next() % bound;
+	}
+
+	inline std::string snowflake() {
+		return std::to_string(1000000000000000000ull + next(100000000000000000ull));
+	}
+
+	inline std::string hash() {
+		static constexpr char digits[]{ "0123456789abcdef" };
+		std::string value(32, '0');
+		for (auto& character: value) {
+			character = digits[next(16)];
+		}
+		return value;
+	}
+
+	inline std::string words(uint64_t count) {
+		static constexpr std::array<const char*, 16> dictionary{ "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "gateway", "shard", "voice", "channel",
+			"emoji", "\"quoted\"", "caf\xC3\xA9", "line\nbreak" };
+		std::string value{};
+		for (uint64_t x = 0; x < count; ++x) {
+			if (x > 0) {
+				value += ' ';
+			}
+			value += dictionary[next(dictionary.size())];
+		}
+		return value;
+	}
+
+	inline std::string timestamp() {
+		return "2026-" + std::to_string(10 + next(3)) + "-" + std::to_string(10 + next(18)) + "T12:34:56.789000+00:00";
+	}
+};
+
+inline User generateUser(corpus_random& random) {
+	User value{};
+	value.id			= random.snowflake();
+	value.username		= "user_" + std::to_string(random.next(1000000));
+	value.discriminator = "0";
+	value.global_name	= random.words(2);
+	value.avatar		= random.hash();
+	value.flags			= random.next(1ull << 20);
+	value.bot			= random.next(8) == 0;
+	return value;
+}
+
+/// @brief Generate a READY payload.
+/// @param index The index of the payload, which seeds its contents.
+/// @param guildCount The number of unavailable guilds it lists.
+inline Payload<ReadyData> generateReady(uint64_t index, uint64_t guildCount) {
+	corpus_random random{ index };
+	Payload<ReadyData> value{ "READY", 0, 1 };
+	value.d.v				   = 10;
+	value.d.user			   = generateUser(random);
+	value.d.session_id		   = random.hash();
+	value.d.session_type	   = "normal";
+	value.d.resume_gateway_url = "wss://gateway-us-east1-b.discord.gg";
+	value.d.shard			   = { static_cast<uint32_t>(index % 16), 16 };
+	for (uint64_t x = 0; x < guildCount; ++x) {
+		value.d.guilds.emplace_back(UnavailableGuild{ random.snowflake(), true });
+	}
+	return value;
+}
+
+/// @brief Generate a GUILD_CREATE payload.
+/// @param index The index of the payload, which seeds its contents.
+/// @param memberCount The number of members it lists.
+inline Payload<GuildCreateData> generateGuildCreate(uint64_t index, uint64_t memberCount) {
+	corpus_random random{ index };
+	Payload<GuildCreateData> value{ "GUILD_CREATE", 0, static_cast<int64_t>(index + 2) };
+	value.d.id			 = random.snowflake();
+	value.d.name		 = random.words(3);
+	value.d.icon		 = random.hash();
+	value.d.owner_id	 = random.snowflake();
+	value.d.member_count = static_cast<int64_t>(memberCount);
+	for (uint64_t x = 0; x < 24; ++x) {
+		value.d.roles.emplace_back(Role{ random.snowflake(), random.words(2), random.next(), static_cast<int64_t>(random.next(1 << 24)), static_cast<int64_t>(x),
+			random.next(2) == 0, random.next(8) == 0, random.next(2) == 0 });
+	}
+	for (uint64_t x = 0; x < 32; ++x) {
+		value.d.channels.emplace_back(
+			Channel{ random.snowflake(), random.words(2), random.words(12), random.snowflake(), static_cast<int64_t>(random.next(6)), static_cast<int64_t>(x), false });
+	}
+	for (uint64_t x = 0; x < memberCount; ++x) {
+		Member member{};
+		member.user		 = generateUser(random);
+		member.nick		 = random.next(4) == 0 ? random.words(1) : std::string{};
+		member.joined_at = random.timestamp();
+		for (uint64_t y = random.next(4); y > 0; --y) {
+			member.roles.emplace_back(value.d.roles[random.next(value.d.roles.size())].id);
+		}
+		value.d.members.emplace_back(std::move(member));
+	}
+	return value;
+}
+
+/// @brief Generate a MESSAGE_CREATE payload, with up to three embeds and up to seven mentions.
+/// @param index The index of the payload, which seeds its contents.
+inline Payload<MessageData> generateMessageCreate(uint64_t index) {
+	corpus_random random{ index };
+	Payload<MessageData> value{ "MESSAGE_CREATE", 0, static_cast<int64_t>(index + 2) };
+	value.d.id		   = random.snowflake();
+	value.d.channel_id = random.snowflake();
+	value.d.guild_id   = random.snowflake();
+	value.d.content	   = random.words(4 + random.next(60));
+	value.d.timestamp  = random.timestamp();
+	value.d.author	   = generateUser(random);
+	for (uint64_t x = random.next(8); x > 0; --x) {
+		value.d.mentions.emplace_back(generateUser(random));
+	}
+	for (uint64_t x = random.next(4); x > 0; --x) {
+		Embed embed{};
+		embed.title		  = random.words(4);
+		embed.type		  = "rich";
+		embed.description = random.words(40);
+		embed.url		  = "https://discord.com/channels/" + random.snowflake();
+		embed.color		  = static_cast<int64_t>(random.next(1 << 24));
+		embed.footer	  = EmbedFooter{ random.words(3), "https://cdn.discordapp.com/avatars/" + random.hash() + ".png" };
+		for (uint64_t y = random.next(6); y > 0; --y) {
+			embed.fields.emplace_back(EmbedField{ random.words(2), random.words(8), random.next(2) == 0 });
+		}
+		value.d.embeds.emplace_back(std::move(embed));
+	}
+	return value;
+}
+
+/// @brief Generate a PRESENCE_UPDATE payload.
+/// @param index The index of the payload, which seeds its contents.
+inline Payload<PresenceData> generatePresenceUpdate(uint64_t index) {
+	static constexpr std::array<const char*, 4> statuses{ "online", "idle", "dnd", "offline" };
+	corpus_random random{ index };
+	Payload<PresenceData> value{ "PRESENCE_UPDATE", 0, static_cast<int64_t>(index + 2) };
+	value.d.user.id	 = random.snowflake();
+	value.d.guild_id = random.snowflake();
+	value.d.status	 = statuses[random.next(statuses.size())];
+	for (uint64_t x = random.next(3); x > 0; --x) {
+		value.d.activities.emplace_back(
+			Activity{ random.words(2), random.words(3), static_cast<int64_t>(random.next(6)), static_cast<int64_t>(1700000000000ull + random.next(100000000000ull)) });
+	}
+	value.d.client_status = ClientStatus{ value.d.status, random.next(2) == 0 ? value.d.status : std::string{} };
+	return value;
+}
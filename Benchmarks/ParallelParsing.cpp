@@ -0,0 +1,63 @@
+﻿// ParallelParsing.cpp : Measures how the throughput of etf_parallel_parser scales with the number of threads.
+// Pass the largest thread count to measure as the first argument, which defaults to the number of hardware threads.
+//
+
+#include <CppEtfer/ParallelParser.hpp>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+std::basic_string<uint8_t> generateFrame(uint64_t index) {
+	CppEtfer::etf_serializer data{};
+	data["op"]							= 0;
+	data["s"]							= index;
+	data["t"]							= "MESSAGE_CREATE";
+	data["d"]["id"]						= std::to_string(1100000000000000000ull + index);
+	data["d"]["channel_id"]				= "1088958712871444512";
+	data["d"]["guild_id"]				= "1088958712326180935";
+	data["d"]["content"]				= "The quick brown fox jumps over the lazy dog, message number " + std::to_string(index) + ".";
+	data["d"]["tts"]					= false;
+	data["d"]["pinned"]					= false;
+	data["d"]["author"]["id"]			= "1088958734577766400";
+	data["d"]["author"]["username"]		= "MBot-MusicHouse-2";
+	data["d"]["author"]["discriminator"] = "0000";
+	data["d"]["author"]["bot"]			= true;
+	for (uint64_t x = 0; x < index % 8; ++x) {
+		CppEtfer::etf_serializer mention{};
+		mention["id"]		= std::to_string(1088958734577766400ull + x);
+		mention["username"] = "user" + std::to_string(x);
+		data["d"]["mentions"].emplaceBack(std::move(mention));
+	}
+	return data;
+}
+
+int main(int argc, char* argv[]) {
+	static constexpr uint64_t frameCount{ 65536 };
+	static constexpr uint64_t iterationCount{ 20 };
+	std::vector<std::basic_string<uint8_t>> frames{};
+	uint64_t totalBytes{};
+	for (uint64_t x = 0; x < frameCount; ++x) {
+		frames.emplace_back(generateFrame(x));
+		totalBytes += frames.back().size();
+	}
+	const uint64_t maxThreads = argc > 1 ? std::stoull(argv[1]) : std::max(std::thread::hardware_concurrency(), 1u);
+	double singleThroughput{};
+	std::cout << "Frames: " << frameCount << ", bytes: " << totalBytes << std::endl;
+	for (uint64_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+		CppEtfer::etf_parallel_parser parser{ threadCount };
+		parser.parseEtfToJson(frames);
+		const auto start = std::chrono::steady_clock::now();
+		for (uint64_t x = 0; x < iterationCount; ++x) {
+			parser.parseEtfToJson(frames);
+		}
+		const double seconds	= std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const double throughput = static_cast<double>(totalBytes * iterationCount) / seconds / 1e6;
+		if (threadCount == 1) {
+			singleThroughput = throughput;
+		}
+		std::cout << "Threads: " << std::setw(3) << threadCount << ", throughput: " << std::fixed << std::setprecision(1) << throughput << " MB/s, "
+				  << std::setprecision(1) << seconds * 1e9 / static_cast<double>(frameCount * iterationCount) << " ns/frame, speedup: " << std::setprecision(2)
+				  << throughput / singleThroughput << "x" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file BatchSerializer.hpp
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+
+#include <vector>
+#include <span>
+
+namespace CppEtfer {
+
+	/// @brief The location of one payload within an etf_batch_serializer's buffer.
+	struct batch_entry {
+		uint64_t offset{};///< The offset of the payload's format version byte within the buffer.
+		uint64_t length{};///< The number of bytes in the payload, including the format version.
+	};
+
+	/// @brief Class for serializing many payloads back-to-back into one contiguous buffer.
+	/// Each payload is a complete ETF term with its own format version, so it can be sent on its own, and the table of entries records where
+	/// each one starts and ends. The buffer and the table are kept between batches, so once they have grown to fit, a batch does not allocate.
+	class etf_batch_serializer {
+	  public:
+		/// @brief Default constructor.
+		inline etf_batch_serializer() = default;
+
+		/// @brief Constructor that sets the limit on how deeply the objects and arrays of etf_serializer trees may be nested.
+		/// @param maxDepthNew The limit on how deeply objects and arrays may be nested.
+		inline explicit etf_batch_serializer(uint64_t maxDepthNew) : maxDepth{ maxDepthNew } {
+		}
+
+		/// @brief Make room for a batch without reallocating.
+		/// @param byteCount The total number of bytes to make room for.
+		/// @param payloadCount The number of payloads to make room for.
+		inline void reserve(uint64_t byteCount, uint64_t payloadCount) {
+			buffer.reserve(byteCount);
+			entries.reserve(payloadCount);
+		}
+
+		/// @brief Serialize an etf_serializer tree onto the end of the batch.
+		/// @param value The tree to be serialized.
+		/// @return The index of the payload within the batch.
+		inline uint64_t add(const etf_serializer& value) {
+			const uint64_t offset = buffer.size();
+			value.serializeAppend(buffer, maxDepth);
+			return addEntry(offset);
+		}
+
+		/// @brief Serialize a value directly onto the end of the batch, without building an etf_serializer tree.
+		/// @tparam value_type The type to serialize, user-defined types are described by a core<value_type> specialization.
+		/// @param value The value to be serialized.
+		/// @return The index of the payload within the batch.
+		template<typename value_type> inline uint64_t add(const value_type& value) {
+			const uint64_t offset = buffer.size();
+			etf_serializer::appendToEtf(value, buffer);
+			return addEntry(offset);
+		}
+
+		/// @brief Get the number of payloads in the batch.
+		/// @return The number of payloads.
+		inline uint64_t size() const {
+			return entries.size();
+		}
+
+		/// @brief Check whether the batch holds no payloads.
+		/// @return True if the batch is empty, false otherwise.
+		inline bool empty() const {
+			return entries.empty();
+		}
+
+		/// @brief Get the bytes of a payload.
+		/// @param index The index of the payload.
+		/// @return The payload, valid until the next call to add() or clear().
+		inline std::span<const uint8_t> operator[](uint64_t index) const {
+			const auto& entry = entries[index];
+			return std::span<const uint8_t>{ buffer.data() + entry.offset, entry.length };
+		}
+
+		/// @brief Get the offset/length table of the payloads, in the order that they were added.
+		/// @return The table, valid until the next call to add() or clear().
+		inline std::span<const batch_entry> table() const {
+			return std::span<const batch_entry>{ entries.data(), entries.size() };
+		}
+
+		/// @brief Get the bytes of every payload, back-to-back.
+		/// @return The bytes, valid until the next call to add() or clear().
+		inline std::span<const uint8_t> data() const {
+			return std::span<const uint8_t>{ buffer.data(), buffer.size() };
+		}
+
+		/// @brief Remove every payload, keeping the storage for the next batch.
+		inline void clear() {
+			buffer.clear();
+			entries.clear();
+		}
+
+	  protected:
+		uninitialized_buffer<uint8_t> buffer{};///< The payloads, back-to-back.
+		std::vector<batch_entry> entries{};///< The offset and length of each payload.
+		uint64_t maxDepth{ defaultMaxDepth };///< The limit on how deeply the objects and arrays of etf_serializer trees may be nested.
+
+		/// @brief Record the payload that was written from an offset to the end of the buffer.
+		/// @param offset The offset of the payload.
+		/// @return The index of the payload.
+		inline uint64_t addEntry(uint64_t offset) {
+			entries.emplace_back(batch_entry{ offset, buffer.size() - offset });
+			return entries.size() - 1;
+		}
+	};
+
+}
@@ -0,0 +1,133 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Buffer.hpp
+
+#pragma once
+
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <memory>
+
+namespace CppEtfer {
+
+	/// @brief A growable buffer of trivial values whose storage is left uninitialized, unlike std::basic_string::resize().
+	/// @tparam value_type_new The type of the stored values.
+	template<typename value_type_new> class uninitialized_buffer {
+	  public:
+		using value_type = value_type_new;
+
+		static_assert(std::is_trivial_v<value_type>, "uninitialized_buffer only holds trivial types.");
+
+		/// @brief Default constructor.
+		inline uninitialized_buffer() = default;
+
+		/// @brief Move assignment operator, which leaves other empty.
+		/// @param other The buffer to be moved into this one.
+		/// @return A reference to this buffer after the move.
+		inline uninitialized_buffer& operator=(uninitialized_buffer&& other) noexcept {
+			values			= std::move(other.values);
+			currentCapacity = std::exchange(other.currentCapacity, 0);
+			currentSize		= std::exchange(other.currentSize, 0);
+			return *this;
+		}
+
+		/// @brief Move constructor, which leaves other empty.
+		/// @param other The buffer to be moved into this one.
+		inline uninitialized_buffer(uninitialized_buffer&& other) noexcept {
+			*this = std::move(other);
+		}
+
+		/// @brief Get a pointer to the stored values.
+		/// @return A pointer to the first stored value.
+		inline value_type* data() {
+			return values.get();
+		}
+
+		/// @brief Get a pointer to the stored values.
+		/// @return A pointer to the first stored value.
+		inline const value_type* data() const {
+			return values.get();
+		}
+
+		/// @brief Get the number of stored values.
+		/// @return The number of stored values.
+		inline uint64_t size() const {
+			return currentSize;
+		}
+
+		/// @brief Get the number of values that can be stored without reallocating.
+		/// @return The current capacity.
+		inline uint64_t capacity() const {
+			return currentCapacity;
+		}
+
+		/// @brief Make room for at least newCapacity values, preserving the stored ones.
+		/// @param newCapacity The number of values to make room for.
+		inline void reserve(uint64_t newCapacity) {
+			if (newCapacity > currentCapacity) {
+				std::unique_ptr<value_type[]> newValues{ new value_type[newCapacity] };
+				if (currentSize > 0) {
+					std::memcpy(newValues.get(), values.get(), currentSize * sizeof(value_type));
+				}
+				values			= std::move(newValues);
+				currentCapacity = newCapacity;
+			}
+		}
+
+		/// @brief Set the number of stored values, leaving any new ones uninitialized.
+		/// @param newSize The new number of stored values.
+		inline void resize(uint64_t newSize) {
+			if (newSize > currentCapacity) {
+				reserve(newSize > currentCapacity * 2 ? newSize : currentCapacity * 2);
+			}
+			currentSize = newSize;
+		}
+
+		/// @brief Append values to the end, growing the storage geometrically.
+		/// @param newValues Pointer to the values to be appended.
+		/// @param count The number of values to be appended.
+		inline void append(const value_type* newValues, uint64_t count) {
+			const uint64_t oldSize = currentSize;
+			resize(currentSize + count);
+			if (count > 0) {
+				std::memcpy(values.get() + oldSize, newValues, count * sizeof(value_type));
+			}
+		}
+
+		/// @brief Remove all of the stored values, keeping the storage.
+		inline void clear() {
+			currentSize = 0;
+		}
+
+	  protected:
+		std::unique_ptr<value_type[]> values{};///< The storage.
+		uint64_t currentCapacity{};///< The number of values that the storage can hold.
+		uint64_t currentSize{};///< The number of stored values.
+	};
+
+}
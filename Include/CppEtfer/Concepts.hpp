@@ -27,23 +27,27 @@
 
 #pragma once
 
+#include <type_traits>
+#include <string_view>
 #include <concepts>
 #include <cstdint>
+#include <utility>
+#include <tuple>
 
 namespace CppEtfer {
 
 	/// @brief Concept for types that are subscriptable with [] operator.
 	template<typename value_type>
-	concept map_subscriptable = requires(value_type data, uint64_t valueNew) {
-		{ data[std::declval<typename value_type::key_type>()] } -> std::same_as<typename value_type::const_reference>;
-	} || requires(value_type data, uint64_t valueNew) {
-		{ data[std::declval<typename value_type::key_type>()] } -> std::same_as<typename value_type::reference>;
+	concept map_subscriptable = requires(value_type data) {
+		{ data[std::declval<typename value_type::key_type>()] } -> std::same_as<const typename value_type::mapped_type&>;
+	} || requires(value_type data) {
+		{ data[std::declval<typename value_type::key_type>()] } -> std::same_as<typename value_type::mapped_type&>;
 	};
 
-	/// @brief Concept for types that have an emplace_back method.
+	/// @brief Concept for types that have an emplace method.
 	template<typename value_type>
 	concept has_emplace = requires(value_type data) {
-		{ data.emplace(std::declval<typename value_type::reference&&>()) } -> std::same_as<typename value_type::reference>;
+		{ data.emplace(std::declval<typename value_type::value_type&&>()) };
 	};
 
 	/// @brief Concept for types that have a begin and end methods.
@@ -132,7 +136,36 @@ namespace CppEtfer {
 		has_range<value_type> && has_resize<std::decay_t<value_type>> && has_emplace_back<std::decay_t<value_type>> && vector_subscriptable<std::decay_t<value_type>> &&
 			requires(value_type other) { typename value_type::value_type; };
 
-	
+	/// @brief Concept for fixed-size array types, such as std::array.
+	template<typename value_type>
+	concept fixed_array_t = has_range<std::decay_t<value_type>> && vector_subscriptable<std::decay_t<value_type>> && !has_resize<std::decay_t<value_type>> &&
+		requires { std::tuple_size<std::decay_t<value_type>>::value; };
 
-	
+	/// @brief Concept for heterogeneous tuple types, such as std::pair and std::tuple.
+	template<typename value_type>
+	concept tuple_t = !has_range<std::decay_t<value_type>> && requires { std::tuple_size<std::decay_t<value_type>>::value; };
+
+	/// @brief Concept for optional (nullable) types.
+	template<typename value_type>
+	concept optional_t = requires(std::decay_t<value_type> data) {
+		typename std::decay_t<value_type>::value_type;
+		{ data.has_value() } -> std::same_as<bool>;
+		{ data.reset() };
+		{ data.emplace() };
+	};
+
+	/// @brief Concept for interned key handles, which compare and hash by ID rather than by their bytes.
+	template<typename value_type>
+	concept interned_key_t = requires(const std::decay_t<value_type> data) {
+		{ data.getId() } -> std::same_as<uint32_t>;
+		{ std::decay_t<value_type>::find(std::string_view{}) };
+	};
+
+	/// @brief Primary template for the compile-time reflection data of a user-defined type.
+	/// @tparam value_type The type being described, specializations provide a static constexpr parseValue member.
+	template<typename value_type> struct core;
+
+	/// @brief Concept for types that have a specialization of core<value_type>.
+	template<typename value_type>
+	concept core_t = requires { core<std::decay_t<value_type>>::parseValue; };
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Constant.hpp
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+#include <array>
+#include <tuple>
+
+namespace CppEtfer {
+
+	/// @brief A constant map, holding its keys and values alternately.
+	/// @tparam value_types The types of the keys and values.
+	template<typename... value_types> struct etf_map_term {
+		static_assert(sizeof...(value_types) % 2 == 0, "etf_map_term holds keys and values in pairs.");
+
+		std::tuple<value_types...> values{};///< The keys and values.
+	};
+
+	/// @brief A constant list.
+	/// @tparam value_types The types of the elements.
+	template<typename... value_types> struct etf_list_term {
+		std::tuple<value_types...> values{};///< The elements.
+	};
+
+	/// @brief A constant atom.
+	struct etf_atom_term {
+		std::string_view name{};///< The name of the atom, of at most 255 bytes.
+	};
+
+	/// @brief Convert an argument of etfMap() or etfList() into the term that stores it, keeping string literals as std::string_views.
+	/// @param value The argument.
+	/// @return The term.
+	template<typename value_type> constexpr auto makeTerm(const value_type& value) {
+		if constexpr (!null_t<value_type> && std::is_convertible_v<const value_type&, std::string_view>) {
+			return std::string_view{ value };
+		} else {
+			return value;
+		}
+	}
+
+	/// @brief Describe a constant map, for etfConstant().
+	/// @param args The keys and values, alternately.
+	/// @return The map.
+	template<typename... value_types> constexpr auto etfMap(const value_types&... args) {
+		return etf_map_term<decltype(makeTerm(args))...>{ std::make_tuple(makeTerm(args)...) };
+	}
+
+	/// @brief Describe a constant list, for etfConstant().
+	/// @param args The elements.
+	/// @return The list.
+	template<typename... value_types> constexpr auto etfList(const value_types&... args) {
+		return etf_list_term<decltype(makeTerm(args))...>{ std::make_tuple(makeTerm(args)...) };
+	}
+
+	/// @brief Describe a constant atom, for etfConstant().
+	/// @param name The name of the atom.
+	/// @return The atom.
+	constexpr etf_atom_term etfAtom(std::string_view name) {
+		return etf_atom_term{ name };
+	}
+
+	template<typename value_type> struct is_map_term : std::false_type {};
+
+	template<typename... value_types> struct is_map_term<etf_map_term<value_types...>> : std::true_type {};
+
+	template<typename value_type> struct is_list_term : std::false_type {};
+
+	template<typename... value_types> struct is_list_term<etf_list_term<value_types...>> : std::true_type {};
+
+	/// @brief Encodes constant terms with the same helpers as etf_serializer, which are constexpr so that they can run at compile-time.
+	struct etf_constant_encoder {
+		/// @brief Writer that copies into an array during constant evaluation.
+		struct array_writer {
+			uint8_t* currentPtr{};///< Pointer to the next byte to be written.
+
+			template<typename value_type> constexpr void write(const value_type* data, uint64_t length) {
+				for (uint64_t x = 0; x < length; ++x) {
+					currentPtr[x] = static_cast<uint8_t>(data[x]);
+				}
+				currentPtr += length;
+			}
+		};
+
+		/// @brief Encode the term returned by a function, including the format version.
+		/// @param function The function returning the term.
+		/// @return The encoded term.
+		template<typename function_type> static consteval auto encode(function_type function) {
+			constexpr auto term = function();
+			constexpr uint64_t size{ [](const auto& termNew) {
+				etf_serializer::size_writer writer{ 1 };
+				writeTerm(writer, termNew);
+				return writer.size;
+			}(term) };
+			std::array<uint8_t, size> result{};
+			array_writer writer{ result.data() };
+			etf_serializer::appendVersion(writer);
+			writeTerm(writer, term);
+			return result;
+		}
+
+		/// @brief Encode a term.
+		/// @param writer The writer to append to.
+		/// @param value The term.
+		template<typename writer_type, typename value_type> static constexpr void writeTerm(writer_type& writer, const value_type& value) {
+			if constexpr (is_map_term<value_type>::value) {
+				constexpr uint64_t count{ std::tuple_size_v<decltype(value.values)> };
+				etf_serializer::appendMapHeader(writer, static_cast<uint32_t>(count / 2));
+				std::apply(
+					[&](const auto&... values) {
+						(writeTerm(writer, values), ...);
+					},
+					value.values);
+			} else if constexpr (is_list_term<value_type>::value) {
+				constexpr uint64_t count{ std::tuple_size_v<decltype(value.values)> };
+				if constexpr (count > 0) {
+					etf_serializer::appendListHeader(writer, static_cast<uint32_t>(count));
+					std::apply(
+						[&](const auto&... values) {
+							(writeTerm(writer, values), ...);
+						},
+						value.values);
+				}
+				etf_serializer::appendNilExt(writer);
+			} else if constexpr (std::same_as<value_type, etf_atom_term>) {
+				if (value.name.size() > 255) {
+					throw std::length_error{ "etf_constant_encoder::writeTerm() Error: Atoms hold at most 255 bytes." };
+				}
+				const uint8_t header[2]{ static_cast<uint8_t>(etf_type::Small_Atom_Utf8_Ext), static_cast<uint8_t>(value.name.size()) };
+				etf_serializer::writeString(writer, header, 2);
+				etf_serializer::writeString(writer, value.name.data(), value.name.size());
+			} else if constexpr (std::same_as<value_type, std::string_view>) {
+				etf_serializer::appendBinaryExt(writer, value, static_cast<uint32_t>(value.size()));
+			} else if constexpr (bool_t<value_type>) {
+				etf_serializer::appendBool(writer, value);
+			} else if constexpr (null_t<value_type>) {
+				etf_serializer::appendNil(writer);
+			} else if constexpr (enum_t<value_type>) {
+				writeTerm(writer, static_cast<std::underlying_type_t<value_type>>(value));
+			} else if constexpr (signed_t<value_type>) {
+				etf_serializer::writeEtfInt(writer, static_cast<int64_t>(value));
+			} else if constexpr (unsigned_t<value_type>) {
+				etf_serializer::writeEtfUint(writer, static_cast<uint64_t>(value));
+			} else if constexpr (float_t<value_type>) {
+				etf_serializer::appendNewFloatExt(writer, static_cast<double>(value));
+			} else if constexpr (requires { value.encode(writer); }) {
+				value.encode(writer);
+			} else {
+				static_assert(std::is_void_v<value_type>, "etfConstant() encodes maps, lists, atoms, strings, booleans, nullptr, enums, integers and floats.");
+			}
+		}
+	};
+
+	/// @brief Encode a constant term to ETF at compile-time, including the format version.
+	/// The term is returned by a function, typically a captureless lambda, so that its size can be known at compile-time. Stored in a static
+	/// constexpr variable, the result lives in read-only memory and costs nothing to produce.
+	/// @param function The function returning the term, built from etfMap(), etfList(), etfAtom() and literal values.
+	/// @return The ETF bytes.
+	template<typename function_type> consteval auto etfConstant(function_type function) {
+		return etf_constant_encoder::encode(function);
+	}
+
+}
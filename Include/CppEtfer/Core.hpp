@@ -0,0 +1,171 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Core.hpp
+
+#pragma once
+
+#include <CppEtfer/Concepts.hpp>
+
+#include <string_view>
+#include <algorithm>
+#include <cstdint>
+#include <array>
+#include <tuple>
+#include <bit>
+
+namespace CppEtfer {
+
+	/// @brief A single named member of a type described by core<value_type>.
+	/// @tparam member_type The pointer-to-member type of the field.
+	template<typename member_type> struct etf_field {
+		std::string_view name{};///< The key that the field is stored under.
+		member_type memberPtr{};///< Pointer to the member that holds the field's value.
+	};
+
+	/// @brief Creates the compile-time field list for a core<value_type> specialization.
+	/// @tparam nameLength The length of the key, including the null-terminator.
+	/// @tparam member_type The pointer-to-member type of the field.
+	/// @tparam value_types The types of the remaining name/member pairs.
+	/// @param name The key that the field is stored under.
+	/// @param memberPtr Pointer to the member that holds the field's value.
+	/// @param args The remaining name/member pairs.
+	/// @return A tuple of etf_field values, in declaration order.
+	template<uint64_t nameLength, typename member_type, typename... value_types>
+		requires(std::is_member_object_pointer_v<member_type> && sizeof...(value_types) % 2 == 0)
+	constexpr auto createObject(const char (&name)[nameLength], member_type memberPtr, value_types&&... args) {
+		auto newField = std::make_tuple(etf_field<member_type>{ std::string_view{ name, nameLength - 1 }, memberPtr });
+		if constexpr (sizeof...(value_types) > 0) {
+			return std::tuple_cat(newField, createObject(std::forward<value_types>(args)...));
+		} else {
+			return newField;
+		}
+	}
+
+	/// @brief The number of fields described by core<value_type>.
+	template<core_t value_type> constexpr uint64_t fieldCount{ std::tuple_size_v<std::decay_t<decltype(core<value_type>::parseValue)>> };
+
+	/// @brief The keys of the fields described by core<value_type>, in declaration order.
+	template<core_t value_type> constexpr auto fieldNames{ []<uint64_t... indices>(std::index_sequence<indices...>) {
+		return std::array<std::string_view, sizeof...(indices)>{ std::get<indices>(core<value_type>::parseValue).name... };
+	}(std::make_index_sequence<fieldCount<value_type>>{}) };
+
+	/// @brief A collision-free hash table over a set of field names, built at compile-time.
+	/// Keys are hashed on their length and on one character counted from each end, with the positions and seed chosen so that no two names
+	/// share a slot. A lookup is then a hash, one load and one comparison against the only name that the key can match. If no such hash
+	/// exists, as for names that differ only in the characters it never samples, lookups fall back to comparing against every name.
+	/// @tparam count The number of names.
+	template<uint64_t count> struct field_hash_table {
+		static_assert(count < 0xFFFF, "field_hash_table holds at most 65534 names.");
+
+		/// @brief The largest number of slots that is tried. Tables of two, four and eight times the number of names, rounded up to a power of two, are tried in turn.
+		static constexpr uint64_t maxTableSize{ std::bit_ceil(count) * 8 };
+		/// @brief The number of positions from each end of a name that are tried for sampling.
+		static constexpr uint8_t maxSampleIndex{ 4 };
+		/// @brief The number of seeds that are tried for each choice of positions.
+		static constexpr uint64_t maxSeed{ 32 };
+
+		std::array<std::string_view, count> names{};///< The names, in field order.
+		std::array<uint16_t, maxTableSize> slots{};///< The index of the name in each slot, or count for empty slots.
+		uint64_t mask{};///< The number of slots in use, minus one.
+		uint64_t seed{};///< The seed mixed into the hash.
+		uint8_t frontIndex{};///< The position of the character sampled from the front of a key.
+		uint8_t backIndex{};///< The position of the character sampled from the back of a key.
+		bool perfect{};///< Whether a collision-free hash was found.
+
+		/// @brief Hash a key.
+		/// @param data Pointer to the key.
+		/// @param length The length of the key.
+		/// @return The hash of the key, before masking.
+		constexpr uint64_t hash(const char* data, uint64_t length) const {
+			uint64_t value{ length };
+			if (length > 0) {
+				value |= uint64_t{ static_cast<uint8_t>(data[std::min<uint64_t>(frontIndex, length - 1)]) } << 16;
+				value |= uint64_t{ static_cast<uint8_t>(data[length - 1 - std::min<uint64_t>(backIndex, length - 1)]) } << 24;
+			}
+			return ((value ^ seed) * 0x9E3779B97F4A7C15ull) >> 32;
+		}
+
+		/// @brief Find the field with a given key.
+		/// @param key The key to search for.
+		/// @return The index of the field, or count if there is none.
+		constexpr uint64_t find(std::string_view key) const {
+			if (perfect) {
+				const uint64_t index = slots[hash(key.data(), key.size()) & mask];
+				return index < count && names[index] == key ? index : count;
+			}
+			for (uint64_t x = 0; x < count; ++x) {
+				if (names[x] == key) {
+					return x;
+				}
+			}
+			return count;
+		}
+
+		/// @brief Try to place every name in its own slot with the current parameters.
+		/// @return True if no two names collided, false otherwise.
+		constexpr bool tryBuild() {
+			std::fill(slots.begin(), slots.begin() + static_cast<std::ptrdiff_t>(mask + 1), static_cast<uint16_t>(count));
+			for (uint64_t x = 0; x < count; ++x) {
+				auto& slot = slots[hash(names[x].data(), names[x].size()) & mask];
+				if (slot != count) {
+					return false;
+				}
+				slot = static_cast<uint16_t>(x);
+			}
+			return true;
+		}
+
+		/// @brief Search for a collision-free hash, preferring fewer slots.
+		/// @param namesNew The names to be hashed.
+		/// @return The table.
+		static constexpr field_hash_table create(const std::array<std::string_view, count>& namesNew) {
+			field_hash_table table{};
+			table.names = namesNew;
+			for (uint64_t size = std::bit_ceil(count) * 2; size <= maxTableSize; size *= 2) {
+				table.mask = size - 1;
+				for (uint8_t front = 0; front < maxSampleIndex; ++front) {
+					for (uint8_t back = 0; back < maxSampleIndex; ++back) {
+						for (uint64_t seedNew = 0; seedNew < maxSeed; ++seedNew) {
+							table.frontIndex = front;
+							table.backIndex	 = back;
+							table.seed		 = seedNew * 0xD6E8FEB86659FD93ull;
+							if (table.tryBuild()) {
+								table.perfect = true;
+								return table;
+							}
+						}
+					}
+				}
+			}
+			table.perfect = false;
+			return table;
+		}
+	};
+
+	/// @brief The compile-time hash table over the keys of the fields described by core<value_type>.
+	template<core_t value_type> constexpr auto fieldHashTable{ field_hash_table<fieldCount<value_type>>::create(fieldNames<value_type>) };
+
+}
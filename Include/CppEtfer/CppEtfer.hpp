@@ -28,14 +28,29 @@
 #pragma once
 
 #include <CppEtfer/Concepts.hpp>
-
-#include <unordered_map>
+#include <CppEtfer/NumberUtils.hpp>
+#include <CppEtfer/StringUtils.hpp>
+#include <CppEtfer/Instrumentation.hpp>
+#include <CppEtfer/Zlib.hpp>
+#include <CppEtfer/KeyTable.hpp>
+#include <CppEtfer/FlatMap.hpp>
+#include <CppEtfer/Buffer.hpp>
+#include <CppEtfer/Core.hpp>
+
+#include <memory_resource>
 #include <string_view>
 #include <stdexcept>
 #include <iostream>
+#include <charconv>
+#include <optional>
 #include <numeric>
 #include <cstring>
+#include <utility>
+#include <limits>
 #include <vector>
+#include <array>
+#include <tuple>
+#include <span>
 #include <string>
 #include <bit>
 
@@ -44,15 +59,15 @@ namespace CppEtfer {
 	/*
 	* We've written these to maximize portability without requiring all of the #ifdefs etc.
 	*/
-	template<typename return_type> inline return_type ntohsNew(return_type value) {
+	template<typename return_type> constexpr return_type ntohsNew(return_type value) {
 		return static_cast<return_type>(((value & 0x00FF) << 8) | ((value & 0xFF00) >> 8));
 	}
 
-	template<typename return_type> inline return_type ntohlNew(return_type value) {
+	template<typename return_type> constexpr return_type ntohlNew(return_type value) {
 		return static_cast<return_type>(((value & 0x000000FF) << 24) | ((value & 0x0000FF00) << 8) | ((value & 0x00FF0000) >> 8) | ((value & 0xFF000000) >> 24));
 	}
 
-	template<typename return_type> inline return_type ntohllNew(return_type value) {
+	template<typename return_type> constexpr return_type ntohllNew(return_type value) {
 		return static_cast<return_type>(((value & 0x00000000000000FFULL) << 56) | ((value & 0x000000000000FF00ULL) << 40) | ((value & 0x0000000000FF0000ULL) << 24) |
 			((value & 0x00000000FF000000ULL) << 8) | ((value & 0x000000FF00000000ULL) >> 8) | ((value & 0x0000FF0000000000ULL) >> 24) |
 			((value & 0x00FF000000000000ULL) >> 40) | ((value & 0xFF00000000000000ULL) >> 56));
@@ -62,7 +77,7 @@ namespace CppEtfer {
 	/// @tparam return_type The type of the value to reverse.
 	/// @param net The value to reverse.
 	/// @return The reversed value.
-	template<typename return_type> inline return_type reverseByteOrder(return_type net) {
+	template<typename return_type> constexpr return_type reverseByteOrder(return_type net) {
 		if constexpr (std::endian::native == std::endian::little) {
 			switch (sizeof(return_type)) {
 			case 2: {
@@ -88,7 +103,7 @@ namespace CppEtfer {
 	/// @tparam return_type The type of the number.
 	/// @param to The character array to store the bits.
 	/// @param num The number whose bits are to be stored.
-	template<typename return_type> inline void storeBits(uint8_t* to, return_type num) {
+	template<typename return_type> constexpr void storeBits(uint8_t* to, return_type num) {
 		const uint8_t byteSize{ 8 };
 		num = reverseByteOrder(num);
 
@@ -100,50 +115,295 @@ namespace CppEtfer {
 
 	/// @brief Enumeration for different ETF value types.
 	enum class etf_type : uint8_t {
+		Distribution_Header = 68,
 		New_Float_Ext = 70,
+		Bit_Binary_Ext = 77,
+		Compressed = 80,
+		Atom_Cache_Ref = 82,
+		New_Pid_Ext = 88,
+		New_Port_Ext = 89,
+		Newer_Reference_Ext = 90,
 		Small_Integer_Ext = 97,
 		Integer_Ext = 98,
+		Float_Ext = 99,
 		Atom_Ext = 100,
+		Reference_Ext = 101,
+		Port_Ext = 102,
+		Pid_Ext = 103,
+		Small_Tuple_Ext = 104,
+		Large_Tuple_Ext = 105,
 		Nil_Ext = 106,
 		String_Ext = 107,
 		List_Ext = 108,
 		Binary_Ext = 109,
 		Small_Big_Ext = 110,
+		Large_Big_Ext = 111,
+		New_Fun_Ext = 112,
+		Export_Ext = 113,
+		New_Reference_Ext = 114,
 		Small_Atom_Ext = 115,
 		Map_Ext = 116,
+		Fun_Ext = 117,
+		Atom_Utf8_Ext = 118,
+		Small_Atom_Utf8_Ext = 119,
+		V4_Port_Ext = 120,
+		Local_Ext = 121,
 	};
 
 	constexpr uint8_t formatVersion{ 131 };
 
+	/// @brief The default limit on how deeply lists and maps may be nested when parsing or serializing.
+	constexpr uint64_t defaultMaxDepth{ 1024 };
+
+	/// @brief The largest big integer, in bytes, that is converted to decimal, since the conversion takes time that grows with the square of
+	/// the length. 256 bytes is over 600 decimal digits.
+	constexpr uint64_t maxBigIntegerBytes{ 256 };
+
+	/// @brief The routing fields of a Discord gateway payload, along with its undecoded event data.
+	struct gateway_envelope {
+		int64_t op{};///< The gateway opcode.
+		std::optional<uint64_t> s{};///< The sequence number, empty if it was nil.
+		std::string_view t{};///< The event name, empty if it was nil, referring into the parsed buffer.
+		std::span<const uint8_t> d{};///< The encoded event data without a format version, referring into the parsed buffer.
+	};
+
 	/// @brief Class for parsing ETF data into JSON format.
 	class etf_parser {
 	public:
+		/// @brief Default constructor.
+		inline etf_parser() = default;
+
+		/// @brief Constructor that sets whether strings are validated as UTF-8 while being parsed.
+		/// @param checkUtf8New Whether to throw on strings that are not well-formed UTF-8.
+		/// @param maxDepthNew The limit on how deeply lists and maps may be nested.
+		inline explicit etf_parser(bool checkUtf8New, uint64_t maxDepthNew = defaultMaxDepth) : maxDepth{ maxDepthNew }, checkUtf8{ checkUtf8New } {
+		}
 
-		/// @brief Parse ETF data to JSON format.
+		/// @brief Parse ETF data to JSON format, reading directly out of the caller's buffer.
 		/// @param dataToParse The ETF data to be parsed.
 		/// @return The JSON representation of the parsed data.
 		template<string_t string_type> inline std::string_view parseEtfToJson(string_type&& dataToParse) {
-			if (dataBuffer.size() < dataToParse.size()) {
-				dataBuffer.resize(dataToParse.size());
-			}
-			std::memcpy(dataBuffer.data(), dataToParse.data(), dataToParse.size());
-			dataSize = dataToParse.size();
-			finalString.clear();
-			currentSize = 0;
-			offSet = 0;
+			loadBuffer(reinterpret_cast<const uint8_t*>(dataToParse.data()), dataToParse.size());
+			return parseJsonImpl();
+		}
+
+		/// @brief Parse ETF data to JSON format, reading directly out of the caller's buffer.
+		/// @param dataToParse The ETF data to be parsed.
+		/// @return The JSON representation of the parsed data.
+		inline std::string_view parseEtfToJson(std::span<const uint8_t> dataToParse) {
+			loadBuffer(dataToParse.data(), dataToParse.size());
+			return parseJsonImpl();
+		}
+
+		/// @brief Parse ETF data to JSON format, taking ownership of the buffer until the next parse or releaseBuffer().
+		/// @param dataToParse The ETF data to be parsed.
+		/// @return The JSON representation of the parsed data.
+		inline std::string_view parseEtfToJson(std::basic_string<uint8_t>&& dataToParse) {
+			ownedBuffer = std::move(dataToParse);
+			loadBuffer(ownedBuffer.data(), ownedBuffer.size());
+			return parseJsonImpl();
+		}
+
+		/// @brief Parse ETF data directly into a value, without an intermediate JSON representation.
+		/// @tparam value_type The type to parse into, user-defined types are described by a core<value_type> specialization.
+		/// @param value The value to be parsed into.
+		/// @param dataToParse The ETF data to be parsed, string_view members of value will refer into it.
+		template<typename value_type, string_t string_type> inline void parseEtfToData(value_type& value, string_type&& dataToParse) {
+			loadBuffer(reinterpret_cast<const uint8_t*>(dataToParse.data()), dataToParse.size());
+			parseDataImpl(value);
+		}
+
+		/// @brief Parse ETF data directly into a value, without an intermediate JSON representation.
+		/// @tparam value_type The type to parse into, user-defined types are described by a core<value_type> specialization.
+		/// @param value The value to be parsed into.
+		/// @param dataToParse The ETF data to be parsed, string_view members of value will refer into it.
+		template<typename value_type> inline void parseEtfToData(value_type& value, std::span<const uint8_t> dataToParse) {
+			loadBuffer(dataToParse.data(), dataToParse.size());
+			parseDataImpl(value);
+		}
+
+		/// @brief Parse ETF data directly into a value, taking ownership of the buffer until the next parse or releaseBuffer().
+		/// @tparam value_type The type to parse into, user-defined types are described by a core<value_type> specialization.
+		/// @param value The value to be parsed into.
+		/// @param dataToParse The ETF data to be parsed, string_view members of value remain valid for as long as the parser owns it.
+		template<typename value_type> inline void parseEtfToData(value_type& value, std::basic_string<uint8_t>&& dataToParse) {
+			ownedBuffer = std::move(dataToParse);
+			loadBuffer(ownedBuffer.data(), ownedBuffer.size());
+			parseDataImpl(value);
+		}
+
+		/// @brief Decode the op, s and t fields of a gateway payload, and skip over d without decoding it.
+		/// @param dataToParse The ETF data to be parsed, which the returned t and d refer into.
+		/// @return The decoded fields, with d left encoded.
+		template<string_t string_type> inline gateway_envelope parseEnvelope(string_type&& dataToParse) {
+			return parseEnvelope(std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(dataToParse.data()), dataToParse.size() });
+		}
+
+		/// @brief Decode the op, s and t fields of a gateway payload, and skip over d without decoding it.
+		/// @param dataToParse The ETF data to be parsed, which the returned t and d refer into.
+		/// @return The decoded fields, with d left encoded.
+		inline gateway_envelope parseEnvelope(std::span<const uint8_t> dataToParse) {
+			loadBuffer(dataToParse.data(), dataToParse.size());
 			if (readBitsFromBuffer<uint8_t>() != formatVersion) {
-				throw std::runtime_error{ "etf_parser::parseEtfToJson() Error: Incorrect format version specified." };
+				throw std::runtime_error{ "etf_parser::parseEnvelope() Error: Incorrect format version specified." };
+			}
+			inflateIfCompressed();
+			if (readBitsFromBuffer<uint8_t>() != static_cast<uint8_t>(etf_type::Map_Ext)) {
+				throw std::runtime_error{ "etf_parser::parseEnvelope() Error: Expected a map." };
+			}
+			gateway_envelope envelope{};
+			const uint32_t length = readBitsFromBuffer<uint32_t>();
+			for (uint32_t x = 0; x < length; ++x) {
+				const auto keyType = peekType();
+				if (!isKeyType(keyType)) {
+					skipValue();
+					skipValue();
+					continue;
+				}
+				++offSet;
+				const std::string_view key = readStringBytes(keyType);
+				if (key == "op") {
+					parseData(envelope.op);
+				} else if (key == "s") {
+					parseData(envelope.s);
+				} else if (key == "t") {
+					parseData(envelope.t);
+				} else if (key == "d") {
+					const uint64_t startOffset = offSet;
+					skipValue();
+					envelope.d = std::span<const uint8_t>{ dataBuffer + startOffset, offSet - startOffset };
+				} else {
+					skipValue();
+				}
 			}
+			return envelope;
+		}
+
+		/// @brief Parse a single ETF value that has no leading format version, such as gateway_envelope::d, to JSON format.
+		/// @param dataToParse The ETF data to be parsed.
+		/// @return The JSON representation of the parsed data.
+		inline std::string_view parseValueToJson(std::span<const uint8_t> dataToParse) {
+			const frame_timer timer{};
+			loadBuffer(dataToParse.data(), dataToParse.size());
+			prepareOutput();
 			singleValueETFToJson();
-			return std::string_view{ finalString.data(), currentSize };
+			timer.finish(etf_frame_kind::parse_json, dataSize, static_cast<uint64_t>(currentPtr - finalString.data()), frameMaxDepth);
+			return std::string_view{ finalString.data(), static_cast<uint64_t>(currentPtr - finalString.data()) };
+		}
+
+		/// @brief Parse a single ETF value that has no leading format version, such as gateway_envelope::d, directly into a value.
+		/// @param value The value to be parsed into.
+		/// @param dataToParse The ETF data to be parsed, string_view members of value will refer into it.
+		template<typename value_type> inline void parseValueToData(value_type& value, std::span<const uint8_t> dataToParse) {
+			const frame_timer timer{};
+			loadBuffer(dataToParse.data(), dataToParse.size());
+			parseData(value);
+			timer.finish(etf_frame_kind::parse_data, dataSize, 0);
+		}
+
+		/// @brief Give back a buffer that was previously moved into the parser, so that its storage can be reused.
+		/// @return The previously owned buffer.
+		inline std::basic_string<uint8_t> releaseBuffer() {
+			if (dataBuffer == ownedBuffer.data()) {
+				dataBuffer = nullptr;
+				dataSize   = 0;
+				offSet	   = 0;
+			}
+			return std::move(ownedBuffer);
 		}
 
 	protected:
-		std::basic_string<uint8_t> dataBuffer{};///< Pointer to ETF data buffer.
-		std::basic_string<char> finalString{};///< The final JSON string.
-		uint64_t currentSize{};///< Current size of the JSON string.
+		/// @brief A list or map whose elements are still being converted to JSON.
+		struct container_frame {
+			uint64_t remaining{};///< The number of elements left to convert, counting keys and values separately for maps.
+			bool isMap{};///< Whether the frame is a map.
+			bool hasTail{};///< Whether the frame is a list, whose elements are followed by a tail.
+		};
+
+		std::basic_string<uint8_t> ownedBuffer{};///< ETF data that was moved into the parser.
+		uninitialized_buffer<uint8_t> inflatedBuffer{};///< The uncompressed contents of a compressed term, reused between parses.
+		uninitialized_buffer<char> finalString{};///< The final JSON string.
+		const uint8_t* dataBuffer{};///< Pointer to ETF data buffer.
+		char* currentPtr{};///< Current end of the JSON string.
 		uint64_t dataSize{};///< Size of the ETF data.
 		uint64_t offSet{};///< Current offset in the ETF data.
+		std::vector<container_frame> containerStack{};///< The lists, tuples and maps being converted to JSON, reused between parses.
+		std::vector<uint32_t> bigScratch{};///< Scratch space for converting big integers of more than 8 bytes to decimal.
+		uint64_t maxDepth{ defaultMaxDepth };///< The limit on how deeply lists and maps may be nested.
+		uint64_t frameMaxDepth{};///< The deepest nesting reached by the current conversion to JSON, only tracked when instrumentationEnabled is true.
+		bool checkUtf8{};///< Whether strings are validated as UTF-8.
+
+		/// @brief Point the parser at a new ETF data buffer and reset the read offset.
+		/// @param data Pointer to the ETF data.
+		/// @param length The size of the ETF data.
+		inline void loadBuffer(const uint8_t* data, uint64_t length) {
+			dataBuffer = data;
+			dataSize   = length;
+			offSet	   = 0;
+		}
+
+		/// @brief If the next value is a compressed term, inflate it into inflatedBuffer and point the parser at the uncompressed term.
+		/// Values that refer into the parsed data, such as string_view members and gateway_envelope::d, then refer into inflatedBuffer, and
+		/// remain valid until the next parse.
+		inline void inflateIfCompressed() {
+			if (offSet >= dataSize || dataBuffer[offSet] != static_cast<uint8_t>(etf_type::Compressed)) {
+				return;
+			}
+			++offSet;
+			const uint32_t size = readBitsFromBuffer<uint32_t>();
+			if (size > maxInflatedTermSize) {
+				throw std::runtime_error{ "etf_parser::inflateIfCompressed() Error: The compressed term declares " + std::to_string(size) + " bytes, more than the limit of " +
+					std::to_string(maxInflatedTermSize) + "." };
+			}
+			inflatedBuffer.resize(size);
+			inflateTerm(dataBuffer + offSet, dataSize - offSet, inflatedBuffer.data(), size);
+			loadBuffer(inflatedBuffer.data(), size);
+		}
+
+		/// @brief Parse the loaded ETF data to JSON format.
+		/// @return The JSON representation of the parsed data.
+		inline std::string_view parseJsonImpl() {
+			const frame_timer timer{};
+			const uint64_t bytesIn = dataSize;
+			if (readBitsFromBuffer<uint8_t>() != formatVersion) {
+				throw std::runtime_error{ "etf_parser::parseEtfToJson() Error: Incorrect format version specified." };
+			}
+			inflateIfCompressed();
+			prepareOutput();
+			singleValueETFToJson();
+			timer.finish(etf_frame_kind::parse_json, bytesIn, static_cast<uint64_t>(currentPtr - finalString.data()), frameMaxDepth);
+			return std::string_view{ finalString.data(), static_cast<uint64_t>(currentPtr - finalString.data()) };
+		}
+
+		/// @brief Size finalString for the loaded ETF data, and point currentPtr at its start.
+		inline void prepareOutput() {
+			const uint64_t oldCapacity = finalString.capacity();
+			finalString.resize(maxJsonSize(dataSize));
+			recordBufferGrowth(etf_frame_kind::parse_json, oldCapacity, finalString.capacity());
+			currentPtr = finalString.data();
+		}
+
+		/// @brief Compute an upper bound on the size of the JSON that an ETF term can produce.
+		/// No tag expands to more than maxEscapedCharSize characters per byte, separators included, the worst case being a binary made up of
+		/// control characters. The slack covers the scratch space that the number formatters may touch past the end of the last value.
+		/// @param length The size of the ETF data.
+		/// @return The maximum number of characters that parsing it can write.
+		inline static uint64_t maxJsonSize(uint64_t length) {
+			return length * maxEscapedCharSize + maxNumberCharSize;
+		}
+
+		/// @brief Parse the loaded ETF data into a value.
+		/// @param value The value to be parsed into.
+		template<typename value_type> inline void parseDataImpl(value_type& value) {
+			const frame_timer timer{};
+			const uint64_t bytesIn = dataSize;
+			if (readBitsFromBuffer<uint8_t>() != formatVersion) {
+				throw std::runtime_error{ "etf_parser::parseEtfToData() Error: Incorrect format version specified." };
+			}
+			inflateIfCompressed();
+			parseData(value);
+			timer.finish(etf_frame_kind::parse_data, bytesIn, 0);
+		}
 
 		/// @brief Read bits from the data buffer and convert to return_type.
 		/// @tparam return_type The type to convert the read data to.
@@ -153,7 +413,7 @@ namespace CppEtfer {
 				throw std::out_of_range{ "etf_parser::readBitsFromBuffer() Error: readBitsFromBuffer() past end of the buffer." };
 			}
 			return_type newValue{};
-			std::memcpy(&newValue, dataBuffer.data() + offSet, sizeof(return_type));
+			std::memcpy(&newValue, dataBuffer + offSet, sizeof(return_type));
 			offSet += sizeof(return_type);
 			newValue = reverseByteOrder(newValue);
 			return newValue;
@@ -163,11 +423,8 @@ namespace CppEtfer {
 		/// @param data Pointer to the data to be written.
 		/// @param length Number of characters to write.
 		template<typename value_type> inline void writeCharacters(const value_type* data, uint64_t length) {
-			if (finalString.size() < currentSize + length) {
-				finalString.resize((finalString.size() + length) * 2);
-			}
-			std::memcpy(finalString.data() + currentSize, data, length);
-			currentSize += length;
+			std::memcpy(currentPtr, data, length);
+			currentPtr += length;
 		}
 
 		/// @brief Write characters from the buffer to the final JSON string.
@@ -180,10 +437,7 @@ namespace CppEtfer {
 			if (offSet + static_cast<uint64_t>(length) > dataSize) {
 				throw std::out_of_range{ "etf_parser::writeCharactersFromBuffer() Error: Read past end of buffer." };
 			}
-			if (finalString.size() < currentSize + length) {
-				finalString.resize((finalString.size() + length) * 2);
-			}
-			const uint8_t* stringNew = dataBuffer.data() + offSet;
+			const uint8_t* stringNew = dataBuffer + offSet;
 			offSet += length;
 			if (length >= 3 && length <= 5) {
 				if (length == 3 && stringNew[0] == 'n' && stringNew[1] == 'i' && stringNew[2] == 'l') {
@@ -203,246 +457,1280 @@ namespace CppEtfer {
 					return;
 				}
 			}
-			writeCharacter<'"'>();
-			for (uint64_t x = 0; x < length; ++x) {
-				switch (stringNew[x]) {
-				case '\\': {
-					switch (stringNew[++x]) {
-					case '\"':
-						writeCharacter<'\"'>();
+			*currentPtr++ = '"';
+			currentPtr	  = escapeString(stringNew, length, currentPtr, checkUtf8);
+			*currentPtr++ = '"';
+		}
+
+		/// @brief Write a string literal to the final JSON string.
+		/// @param data The string literal to write.
+		template<uint64_t length> inline void writeCharacters(const char (&data)[length]) {
+			writeCharacters(data, length - 1);
+		}
+
+		/// @brief Write a character to the final JSON string.
+		/// @param value The character to write.
+		inline void writeCharacter(const char value) {
+			*currentPtr++ = value;
+		}
+
+		/// @brief Write a character to the final JSON string.
+		/// @tparam value The character to write.
+		template<const char charToWrite> inline void writeCharacter() {
+			*currentPtr++ = charToWrite;
+		}
+
+		/// @brief Parse a single ETF value and convert to JSON.
+		/// Lists, tuples and maps are tracked on containerStack instead of by recursion, so the nesting depth is bounded by maxDepth rather
+		/// than by the size of the call stack. The tail of an improper list is converted as its last element.
+		inline void singleValueETFToJson() {
+			containerStack.clear();
+			if constexpr (instrumentationEnabled) {
+				frameMaxDepth = 0;
+			}
+			do {
+				if (recordValueOrOpen()) {
+					continue;
+				}
+				while (!containerStack.empty()) {
+					auto& frame = containerStack.back();
+					if (--frame.remaining > 0) {
+						writeCharacter(frame.isMap && (frame.remaining & 1) ? ':' : ',');
 						break;
-					case '\\':
-						writeCharacter<'\\'>();
+					}
+					if (frame.isMap) {
+						writeCharacter<'}'>();
+					} else if (frame.hasTail && peekType() != etf_type::Nil_Ext) {
+						frame.remaining = 1;
+						frame.hasTail	= false;
+						writeCharacter<','>();
 						break;
-					case 'b':
-						writeCharacter<'\b'>();
+					} else {
+						if (frame.hasTail) {
+							++offSet;
+						}
+						writeCharacter<']'>();
+					}
+					containerStack.pop_back();
+				}
+			} while (!containerStack.empty());
+		}
+
+		/// @brief Push a list, tuple or map onto containerStack.
+		/// @param remaining The number of elements in the container, counting keys and values separately for maps.
+		/// @param isMap Whether the container is a map.
+		/// @param hasTail Whether the container is a list, whose elements are followed by a tail.
+		inline void pushContainer(uint64_t remaining, bool isMap, bool hasTail) {
+			if (containerStack.size() >= maxDepth) {
+				throw std::runtime_error{ "etf_parser::pushContainer() Error: Exceeded the maximum nesting depth of " + std::to_string(maxDepth) + "." };
+			}
+			containerStack.emplace_back(container_frame{ remaining, isMap, hasTail });
+			if constexpr (instrumentationEnabled) {
+				frameMaxDepth = std::max<uint64_t>(frameMaxDepth, containerStack.size());
+			}
+		}
+
+		/// @brief Call parseValueOrOpen(), and record the tag and the bytes read and written in etf_metrics if instrumentationEnabled is true.
+		/// @return True if a non-empty list, tuple or map was opened, false if a complete value was converted.
+		inline bool recordValueOrOpen() {
+			if constexpr (instrumentationEnabled) {
+				const uint64_t startOffset = offSet;
+				const char* startPtr	   = currentPtr;
+				const bool opened		   = parseValueOrOpen();
+				etf_metrics::global().recordTag(false, dataBuffer[startOffset], offSet - startOffset, static_cast<uint64_t>(currentPtr - startPtr));
+				return opened;
+			} else {
+				return parseValueOrOpen();
+			}
+		}
+
+		/// @brief Convert a scalar ETF value to JSON, or open a list, tuple or map.
+		/// @return True if a non-empty list, tuple or map was opened, false if a complete value was converted.
+		inline bool parseValueOrOpen() {
+			if (offSet > dataSize) {
+				throw std::out_of_range{ "etf_parser::singleValueETFToJson() Error: Read past end of buffer." };
+			}
+			uint8_t type = readBitsFromBuffer<int8_t>();
+			switch (static_cast<etf_type>(type)) {
+			case etf_type::New_Float_Ext: {
+				parseNewFloatExt();
+				return false;
+			}
+			case etf_type::Small_Integer_Ext: {
+				parseSmallIntegerExt();
+				return false;
+			}
+			case etf_type::Integer_Ext: {
+				parseIntegerExt();
+				return false;
+			}
+			case etf_type::Atom_Ext: {
+				parseAtomExt();
+				return false;
+			}
+			case etf_type::Nil_Ext: {
+				parseNilExt();
+				return false;
+			}
+			case etf_type::String_Ext: {
+				parseStringExt();
+				return false;
+			}
+			case etf_type::List_Ext: {
+				return parseListExt();
+			}
+			case etf_type::Binary_Ext: {
+				parseBinaryExt();
+				return false;
+			}
+			case etf_type::Small_Big_Ext: {
+				parseSmallBigExt();
+				return false;
+			}
+			case etf_type::Small_Atom_Ext: {
+				parseSmallAtomExt();
+				return false;
+			}
+			case etf_type::Map_Ext: {
+				return parseMapExt();
+			}
+			case etf_type::Small_Tuple_Ext: {
+				return parseTupleExt(readBitsFromBuffer<uint8_t>());
+			}
+			case etf_type::Large_Tuple_Ext: {
+				return parseTupleExt(readBitsFromBuffer<uint32_t>());
+			}
+			case etf_type::Atom_Utf8_Ext: {
+				parseAtomExt();
+				return false;
+			}
+			case etf_type::Small_Atom_Utf8_Ext: {
+				parseSmallAtomExt();
+				return false;
+			}
+			case etf_type::Large_Big_Ext: {
+				parseLargeBigExt();
+				return false;
+			}
+			case etf_type::Float_Ext: {
+				parseFloatExt();
+				return false;
+			}
+			case etf_type::Bit_Binary_Ext: {
+				parseBitBinaryExt();
+				return false;
+			}
+			case etf_type::Pid_Ext:
+			case etf_type::New_Pid_Ext: {
+				parsePidExt(static_cast<etf_type>(type));
+				return false;
+			}
+			case etf_type::Port_Ext:
+			case etf_type::New_Port_Ext:
+			case etf_type::V4_Port_Ext: {
+				parsePortExt(static_cast<etf_type>(type));
+				return false;
+			}
+			case etf_type::Reference_Ext:
+			case etf_type::New_Reference_Ext:
+			case etf_type::Newer_Reference_Ext: {
+				parseReferenceExt(static_cast<etf_type>(type));
+				return false;
+			}
+			case etf_type::Export_Ext: {
+				parseExportExt();
+				return false;
+			}
+			case etf_type::New_Fun_Ext: {
+				parseNewFunExt();
+				return false;
+			}
+			default: {
+				throw std::runtime_error{ "etf_parser::singleValueETFToJson() Error: Unknown data type in ETF, the type: " + std::to_string(type) };
+			}
+			}
+		}
+
+		/// @brief Parse ETF data representing a list and open a JSON array.
+		/// @return True if the list has elements to convert, false if it was empty and has been closed.
+		inline bool parseListExt() {
+			uint32_t length = readBitsFromBuffer<uint32_t>();
+			writeCharacter<'['>();
+			if (static_cast<uint64_t>(offSet) + length > dataSize) {
+				throw std::out_of_range{ "etf_parser::parseListExt() Error: Read past end of buffer." };
+			}
+			if (length == 0) {
+				readBitsFromBuffer<uint8_t>();
+				writeCharacter<']'>();
+				return false;
+			}
+			pushContainer(length, false, true);
+			return true;
+		}
+
+		/// @brief Parse ETF data representing a tuple and open a JSON array.
+		/// @param length The arity of the tuple.
+		/// @return True if the tuple has elements to convert, false if it was empty and has been closed.
+		inline bool parseTupleExt(uint32_t length) {
+			writeCharacter<'['>();
+			if (static_cast<uint64_t>(offSet) + length > dataSize) {
+				throw std::out_of_range{ "etf_parser::parseTupleExt() Error: Read past end of buffer." };
+			}
+			if (length == 0) {
+				writeCharacter<']'>();
+				return false;
+			}
+			pushContainer(length, false, false);
+			return true;
+		}
+
+		/// @brief Parse ETF data representing a small integer and convert to JSON number.
+		inline void parseSmallIntegerExt() {
+			const auto& chars = smallIntegerTable[readBitsFromBuffer<uint8_t>()];
+			std::memcpy(currentPtr, chars.chars, sizeof(chars.chars));
+			currentPtr += chars.length;
+		}
+
+		/// @brief Parse ETF data representing an integer and convert to JSON number.
+		inline void parseIntegerExt() {
+			currentPtr = toChars(currentPtr, readBitsFromBuffer<int32_t>());
+		}
+
+		/// @brief Parse ETF data representing a string, which ETF uses for lists of small integers, and convert to a JSON array of numbers.
+		inline void parseStringExt() {
+			const uint16_t length = readBitsFromBuffer<uint16_t>();
+			const uint8_t* bytes  = readBytesFromBuffer(length);
+			writeCharacter<'['>();
+			for (uint16_t x = 0; x < length; ++x) {
+				if (x > 0) {
+					writeCharacter<','>();
+				}
+				const auto& chars = smallIntegerTable[bytes[x]];
+				std::memcpy(currentPtr, chars.chars, sizeof(chars.chars));
+				currentPtr += chars.length;
+			}
+			writeCharacter<']'>();
+		}
+
+		/// @brief Parse ETF data representing a new float and convert to JSON number.
+		inline void parseNewFloatExt() {
+			currentPtr = toChars(currentPtr, std::bit_cast<double>(readBitsFromBuffer<uint64_t>()));
+		}
+
+		/// @brief Parse ETF data representing an old-style float, stored as text, and convert to JSON number.
+		inline void parseFloatExt() {
+			currentPtr = toChars(currentPtr, parseFloatText());
+		}
+
+		/// @brief Read the value of a Float_Ext, whose tag has already been consumed.
+		/// @return The value.
+		inline double parseFloatText() {
+			const char* digits = reinterpret_cast<const char*>(readBytesFromBuffer(31));
+			const char* end	   = static_cast<const char*>(std::memchr(digits, '\0', 31));
+			double value{};
+			const auto result = std::from_chars(digits, end ? end : digits + 31, value);
+			if (result.ec != std::errc{}) {
+				throw std::runtime_error{ "etf_parser::parseFloatText() Error: Invalid float." };
+			}
+			return value;
+		}
+
+		/// @brief Parse ETF data representing a small big integer and convert to a JSON string of its decimal digits.
+		inline void parseSmallBigExt() {
+			writeBigInteger(readBitsFromBuffer<uint8_t>());
+		}
+
+		/// @brief Parse ETF data representing a large big integer and convert to a JSON string of its decimal digits.
+		inline void parseLargeBigExt() {
+			writeBigInteger(readBitsFromBuffer<uint32_t>());
+		}
+
+		/// @brief Convert the sign and bytes of a big integer to a JSON string of its decimal digits, which need not fit in 64 bits.
+		/// @param digits The number of bytes in the integer.
+		inline void writeBigInteger(uint64_t digits) {
+			bool sign{};
+			const uint8_t* bytes = readBigBytes(digits, sign);
+			*currentPtr++		 = '"';
+			if (sign) {
+				*currentPtr++ = '-';
+			}
+			if (digits <= 8) {
+				currentPtr = toChars(currentPtr, loadMagnitude(bytes, digits));
+			} else {
+				currentPtr = bigToChars(currentPtr, bytes, digits, bigScratch);
+			}
+			*currentPtr++ = '"';
+		}
+
+		/// @brief Parse ETF data representing an atom and convert to JSON string.
+		inline void parseAtomExt() {
+			writeCharactersFromBuffer(readBitsFromBuffer<uint16_t>());
+		}
+
+		/// @brief Parse ETF data representing a binary and convert to JSON string.
+		inline void parseBinaryExt() {
+			writeCharactersFromBuffer(readBitsFromBuffer<uint32_t>());
+		}
+
+		/// @brief Parse ETF data representing a nil value and convert to JSON null.
+		inline void parseNilExt() {
+			writeCharacters("[]", 2);
+		}
+
+		/// @brief Parse ETF data representing a small atom and convert to JSON string.
+		inline void parseSmallAtomExt() {
+			writeCharactersFromBuffer(readBitsFromBuffer<uint8_t>());
+		}
+
+		/// @brief Parse ETF data representing a bitstring and convert to JSON string, including every bit of its last byte.
+		inline void parseBitBinaryExt() {
+			const uint32_t length = readBitsFromBuffer<uint32_t>();
+			readBitsFromBuffer<uint8_t>();
+			writeCharactersFromBuffer(length);
+		}
+
+		/// @brief Parse ETF data representing a process identifier and convert to a JSON object of its node, id, serial and creation.
+		/// @param type Pid_Ext or New_Pid_Ext.
+		inline void parsePidExt(etf_type type) {
+			writeCharacters("{\"node\":");
+			writeAtomString();
+			writeCharacters(",\"id\":");
+			currentPtr = toChars(currentPtr, readBitsFromBuffer<uint32_t>());
+			writeCharacters(",\"serial\":");
+			currentPtr = toChars(currentPtr, readBitsFromBuffer<uint32_t>());
+			writeCharacters(",\"creation\":");
+			writeCreation(type != etf_type::Pid_Ext);
+			writeCharacter<'}'>();
+		}
+
+		/// @brief Parse ETF data representing a port and convert to a JSON object of its node, id and creation.
+		/// @param type Port_Ext, New_Port_Ext or V4_Port_Ext.
+		inline void parsePortExt(etf_type type) {
+			writeCharacters("{\"node\":");
+			writeAtomString();
+			writeCharacters(",\"id\":");
+			if (type == etf_type::V4_Port_Ext) {
+				currentPtr = toChars(currentPtr, readBitsFromBuffer<uint64_t>());
+			} else {
+				currentPtr = toChars(currentPtr, readBitsFromBuffer<uint32_t>());
+			}
+			writeCharacters(",\"creation\":");
+			writeCreation(type != etf_type::Port_Ext);
+			writeCharacter<'}'>();
+		}
+
+		/// @brief Parse ETF data representing a reference and convert to a JSON object of its node, creation and array of ids.
+		/// @param type Reference_Ext, New_Reference_Ext or Newer_Reference_Ext.
+		inline void parseReferenceExt(etf_type type) {
+			const uint16_t length = type == etf_type::Reference_Ext ? 1 : readBitsFromBuffer<uint16_t>();
+			writeCharacters("{\"node\":");
+			writeAtomString();
+			uint64_t idOffset{ offSet };
+			if (type == etf_type::Reference_Ext) {
+				readBytesFromBuffer(4);
+			}
+			writeCharacters(",\"creation\":");
+			writeCreation(type == etf_type::Newer_Reference_Ext);
+			if (type != etf_type::Reference_Ext) {
+				idOffset = offSet;
+				readBytesFromBuffer(static_cast<uint64_t>(length) * 4);
+			}
+			writeCharacters(",\"id\":[");
+			for (uint16_t x = 0; x < length; ++x) {
+				if (x > 0) {
+					writeCharacter<','>();
+				}
+				uint32_t newId{};
+				std::memcpy(&newId, dataBuffer + idOffset + x * 4ull, sizeof(newId));
+				currentPtr = toChars(currentPtr, reverseByteOrder(newId));
+			}
+			writeCharacters("]}");
+		}
+
+		/// @brief Parse ETF data representing an exported function and convert to a JSON object of its module, function and arity.
+		inline void parseExportExt() {
+			writeCharacters("{\"module\":");
+			writeAtomString();
+			writeCharacters(",\"function\":");
+			writeAtomString();
+			writeCharacters(",\"arity\":");
+			currentPtr = toChars(currentPtr, readNumber<uint64_t>());
+			writeCharacter<'}'>();
+		}
+
+		/// @brief Parse ETF data representing a fun and convert to a JSON object of its module and arity, skipping its environment.
+		inline void parseNewFunExt() {
+			const uint64_t startOffset = offSet;
+			const uint32_t size		   = readBitsFromBuffer<uint32_t>();
+			if (size < 4 || startOffset + size > dataSize) {
+				throw std::out_of_range{ "etf_parser::parseNewFunExt() Error: Read past end of buffer." };
+			}
+			const uint8_t arity = readBitsFromBuffer<uint8_t>();
+			readBytesFromBuffer(24);
+			writeCharacters("{\"module\":");
+			writeAtomString();
+			writeCharacters(",\"arity\":");
+			currentPtr = toChars(currentPtr, arity);
+			writeCharacter<'}'>();
+			if (offSet > startOffset + size) {
+				throw std::runtime_error{ "etf_parser::parseNewFunExt() Error: Invalid fun size." };
+			}
+			offSet = startOffset + size;
+		}
+
+		/// @brief Read the creation of a pid, port or reference and convert to JSON number.
+		/// @param isWide Whether the creation is 4 bytes, as in the newer tags, rather than 1.
+		inline void writeCreation(bool isWide) {
+			if (isWide) {
+				currentPtr = toChars(currentPtr, readBitsFromBuffer<uint32_t>());
+			} else {
+				currentPtr = toChars(currentPtr, readBitsFromBuffer<uint8_t>());
+			}
+		}
+
+		/// @brief Read an atom, such as the node of a pid, and convert to JSON string, without mapping nil, true or false.
+		inline void writeAtomString() {
+			const std::string_view atom = readAtom();
+			*currentPtr++				= '"';
+			currentPtr					= escapeString(reinterpret_cast<const uint8_t*>(atom.data()), atom.size(), currentPtr, checkUtf8);
+			*currentPtr++				= '"';
+		}
+
+		/// @brief Parse ETF data representing a map and open a JSON object.
+		/// @return True if the map has pairs to convert, false if it was empty and has been closed.
+		inline bool parseMapExt() {
+			uint32_t length = readBitsFromBuffer<uint32_t>();
+			writeCharacter<'{'>();
+			if (length == 0) {
+				writeCharacter<'}'>();
+				return false;
+			}
+			pushContainer(static_cast<uint64_t>(length) * 2, true, false);
+			return true;
+		}
+
+		/// @brief Return a pointer to the next length bytes of the data buffer, and advance past them.
+		/// @param length The number of bytes to consume.
+		/// @return A pointer to the first consumed byte.
+		inline const uint8_t* readBytesFromBuffer(uint64_t length) {
+			if (offSet + length > dataSize) {
+				throw std::out_of_range{ "etf_parser::readBytesFromBuffer() Error: Read past end of buffer." };
+			}
+			const uint8_t* newPtr = dataBuffer + offSet;
+			offSet += length;
+			return newPtr;
+		}
+
+		/// @brief Peek at the type of the next ETF value without consuming it.
+		/// @return The type of the next value.
+		inline etf_type peekType() const {
+			if (offSet >= dataSize) {
+				throw std::out_of_range{ "etf_parser::peekType() Error: Read past end of buffer." };
+			}
+			return static_cast<etf_type>(dataBuffer[offSet]);
+		}
+
+		/// @brief Consume the next ETF value if it is the atom nil, which is how null values are encoded.
+		/// @return True if a nil atom was consumed, false otherwise.
+		inline bool readNilAtom() {
+			const uint8_t* stringNew = dataBuffer + offSet;
+			if (offSet + 5 <= dataSize && (stringNew[0] == static_cast<uint8_t>(etf_type::Small_Atom_Ext) || stringNew[0] == static_cast<uint8_t>(etf_type::Small_Atom_Utf8_Ext)) &&
+				stringNew[1] == 3 && std::memcmp(stringNew + 2, "nil", 3) == 0) {
+				offSet += 5;
+				return true;
+			} else if (offSet + 6 <= dataSize && (stringNew[0] == static_cast<uint8_t>(etf_type::Atom_Ext) || stringNew[0] == static_cast<uint8_t>(etf_type::Atom_Utf8_Ext)) &&
+				stringNew[1] == 0 && stringNew[2] == 3 && std::memcmp(stringNew + 3, "nil", 3) == 0) {
+				offSet += 6;
+				return true;
+			}
+			return false;
+		}
+
+		/// @brief Check whether a value of a given type can be the key of a map field.
+		/// @param type The type of the value.
+		/// @return True for atoms and binaries, false otherwise.
+		inline static bool isKeyType(etf_type type) {
+			switch (type) {
+				case etf_type::Atom_Ext:
+				case etf_type::Small_Atom_Ext:
+				case etf_type::Atom_Utf8_Ext:
+				case etf_type::Small_Atom_Utf8_Ext:
+				case etf_type::Binary_Ext: {
+					return true;
+				}
+				default: {
+					return false;
+				}
+			}
+		}
+
+		/// @brief Read the bytes of an atom, string or binary value.
+		/// @param type The type of the value, which has already been consumed.
+		/// @return A view of the value's bytes.
+		inline std::string_view readStringBytes(etf_type type) {
+			uint64_t length{};
+			switch (type) {
+				case etf_type::Atom_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Atom_Utf8_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::String_Ext: {
+					length = readBitsFromBuffer<uint16_t>();
+					break;
+				}
+				case etf_type::Small_Atom_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Atom_Utf8_Ext: {
+					length = readBitsFromBuffer<uint8_t>();
+					break;
+				}
+				case etf_type::Binary_Ext: {
+					length = readBitsFromBuffer<uint32_t>();
+					break;
+				}
+				case etf_type::Bit_Binary_Ext: {
+					length = readBitsFromBuffer<uint32_t>();
+					readBitsFromBuffer<uint8_t>();
+					break;
+				}
+				default: {
+					throw std::runtime_error{ "etf_parser::readStringBytes() Error: Expected a string, but found the type: " + std::to_string(static_cast<uint32_t>(type)) };
+				}
+			}
+			return std::string_view{ reinterpret_cast<const char*>(readBytesFromBuffer(length)), length };
+		}
+
+		/// @brief Read an atom, such as the node of a pid.
+		/// @return A view of the atom's bytes.
+		inline std::string_view readAtom() {
+			const auto type = static_cast<etf_type>(readBitsFromBuffer<uint8_t>());
+			switch (type) {
+				case etf_type::Atom_Ext:
+				case etf_type::Small_Atom_Ext:
+				case etf_type::Atom_Utf8_Ext:
+				case etf_type::Small_Atom_Utf8_Ext: {
+					return readStringBytes(type);
+				}
+				default: {
+					throw std::runtime_error{ "etf_parser::readAtom() Error: Expected an atom, but found the type: " + std::to_string(static_cast<uint32_t>(type)) };
+				}
+			}
+		}
+
+		/// @brief Read the sign and bytes of a Small_Big_Ext or Large_Big_Ext value, whose length has already been consumed.
+		/// @param digits The number of bytes in the value.
+		/// @param sign Set to true if the value is negative.
+		/// @return A pointer to the bytes of the value, least significant first.
+		inline const uint8_t* readBigBytes(uint64_t digits, bool& sign) {
+			checkBigIntegerSize(digits);
+			sign = readBitsFromBuffer<uint8_t>() != 0;
+			return readBytesFromBuffer(digits);
+		}
+
+		/// @brief Check that a big integer is short enough to be converted, before any of it is read.
+		/// @param digits The number of bytes in the value.
+		inline static void checkBigIntegerSize(uint64_t digits) {
+			if (digits > maxBigIntegerBytes) {
+				throw std::runtime_error{ "etf_parser::checkBigIntegerSize() Error: The big integer has " + std::to_string(digits) + " bytes, more than the limit of " +
+					std::to_string(maxBigIntegerBytes) + "." };
+			}
+		}
+
+		/// @brief Combine the bytes of a big integer of at most 8 bytes.
+		/// @param bytes Pointer to the bytes, least significant first.
+		/// @param digits The number of bytes.
+		/// @return The magnitude of the value.
+		inline static uint64_t loadMagnitude(const uint8_t* bytes, uint64_t digits) {
+			uint64_t value{};
+			for (uint64_t x = 0; x < digits; ++x) {
+				value |= static_cast<uint64_t>(bytes[x]) << (8 * x);
+			}
+			return value;
+		}
+
+		/// @brief Read the magnitude of a Small_Big_Ext or Large_Big_Ext value, whose tag has already been consumed, as a 64-bit integer.
+		/// @param type The type of the value.
+		/// @param sign Set to true if the value is negative.
+		/// @return The magnitude of the value.
+		inline uint64_t readBigMagnitude(etf_type type, bool& sign) {
+			const uint64_t digits = type == etf_type::Small_Big_Ext ? readBitsFromBuffer<uint8_t>() : readBitsFromBuffer<uint32_t>();
+			const uint8_t* bytes  = readBigBytes(digits, sign);
+			if (digits > 8) {
+				throw std::runtime_error{ "etf_parser::readBigMagnitude() Error: Big integers larger than 8 bytes do not fit in a 64-bit integer." };
+			}
+			return loadMagnitude(bytes, digits);
+		}
+
+		/// @brief Load a big-endian value.
+		/// @tparam return_type The type of the value.
+		/// @param data Pointer to the value.
+		/// @return The value.
+		template<typename return_type> inline static return_type loadBits(const uint8_t* data) {
+			return_type newValue{};
+			std::memcpy(&newValue, data, sizeof(return_type));
+			return reverseByteOrder(newValue);
+		}
+
+		/// @brief Get the size of a value from its leading bytes, without reading past them.
+		/// For lists, tuples and maps only the size of the tag and header is returned. Pids, ports, references, exports and funs are sized
+		/// along with the atoms and integers nested within them.
+		/// @param data Pointer to the tag of the value.
+		/// @param length The number of bytes available.
+		/// @return The size of the value, or, if more than length bytes are needed to tell, a larger size that must be available before asking
+		/// again.
+		inline static uint64_t valueSize(const uint8_t* data, uint64_t length) {
+			if (length < 1) {
+				return 1;
+			}
+			const auto withHeader = [&](uint64_t headerSize, auto&& bodySize) -> uint64_t {
+				return length < headerSize ? headerSize : headerSize + bodySize();
+			};
+			const auto withNested = [&](uint64_t prefixSize, uint64_t nestedCount, uint64_t suffixSize) -> uint64_t {
+				uint64_t size{ prefixSize };
+				for (uint64_t x = 0; x < nestedCount; ++x) {
+					if (size >= length) {
+						return size + 1;
+					}
+					size += valueSize(data + size, length - size);
+				}
+				return size + suffixSize;
+			};
+			switch (static_cast<etf_type>(data[0])) {
+				case etf_type::Nil_Ext: {
+					return 1;
+				}
+				case etf_type::Small_Integer_Ext:
+				case etf_type::Small_Tuple_Ext: {
+					return 2;
+				}
+				case etf_type::Integer_Ext:
+				case etf_type::List_Ext:
+				case etf_type::Large_Tuple_Ext:
+				case etf_type::Map_Ext: {
+					return 5;
+				}
+				case etf_type::New_Float_Ext: {
+					return 9;
+				}
+				case etf_type::Float_Ext: {
+					return 32;
+				}
+				case etf_type::Small_Atom_Ext:
+				case etf_type::Small_Atom_Utf8_Ext: {
+					return withHeader(2, [&] {
+						return uint64_t{ data[1] };
+					});
+				}
+				case etf_type::Atom_Ext:
+				case etf_type::Atom_Utf8_Ext:
+				case etf_type::String_Ext: {
+					return withHeader(3, [&] {
+						return uint64_t{ loadBits<uint16_t>(data + 1) };
+					});
+				}
+				case etf_type::Small_Big_Ext: {
+					return withHeader(3, [&] {
+						return uint64_t{ data[1] };
+					});
+				}
+				case etf_type::Binary_Ext: {
+					return withHeader(5, [&] {
+						return uint64_t{ loadBits<uint32_t>(data + 1) };
+					});
+				}
+				case etf_type::Bit_Binary_Ext:
+				case etf_type::Large_Big_Ext: {
+					return withHeader(6, [&] {
+						return uint64_t{ loadBits<uint32_t>(data + 1) };
+					});
+				}
+				case etf_type::New_Fun_Ext: {
+					return withHeader(5, [&] {
+						return std::max(uint64_t{ loadBits<uint32_t>(data + 1) }, uint64_t{ 4 }) - 4;
+					});
+				}
+				case etf_type::Pid_Ext: {
+					return withNested(1, 1, 9);
+				}
+				case etf_type::New_Pid_Ext:
+				case etf_type::V4_Port_Ext: {
+					return withNested(1, 1, 12);
+				}
+				case etf_type::Port_Ext:
+				case etf_type::Reference_Ext: {
+					return withNested(1, 1, 5);
+				}
+				case etf_type::New_Port_Ext: {
+					return withNested(1, 1, 8);
+				}
+				case etf_type::New_Reference_Ext:
+				case etf_type::Newer_Reference_Ext: {
+					if (length < 3) {
+						return 3;
+					}
+					const uint64_t creationSize = static_cast<etf_type>(data[0]) == etf_type::New_Reference_Ext ? 1 : 4;
+					return withNested(3, 1, creationSize + uint64_t{ loadBits<uint16_t>(data + 1) } * 4);
+				}
+				case etf_type::Export_Ext: {
+					return withNested(1, 3, 0);
+				}
+				default: {
+					throw std::runtime_error{ "etf_parser::valueSize() Error: Unknown data type in ETF, the type: " + std::to_string(data[0]) };
+				}
+			}
+		}
+
+		/// @brief Skip over the next ETF value, including all of its children.
+		inline void skipValue() {
+			uint64_t remaining{ 1 };
+			while (remaining > 0) {
+				--remaining;
+				uint8_t type = readBitsFromBuffer<uint8_t>();
+				switch (static_cast<etf_type>(type)) {
+					case etf_type::New_Float_Ext: {
+						readBytesFromBuffer(8);
+						break;
+					}
+					case etf_type::Small_Integer_Ext: {
+						readBytesFromBuffer(1);
+						break;
+					}
+					case etf_type::Integer_Ext: {
+						readBytesFromBuffer(4);
+						break;
+					}
+					case etf_type::Atom_Ext: {
+						[[fallthrough]];
+					}
+					case etf_type::String_Ext: {
+						readBytesFromBuffer(readBitsFromBuffer<uint16_t>());
+						break;
+					}
+					case etf_type::Nil_Ext: {
 						break;
-					case 'f':
-						writeCharacter<'\f'>();
+					}
+					case etf_type::List_Ext: {
+						remaining += static_cast<uint64_t>(readBitsFromBuffer<uint32_t>()) + 1;
 						break;
-					case 'n':
-						writeCharacter<'\n'>();
+					}
+					case etf_type::Binary_Ext: {
+						readBytesFromBuffer(readBitsFromBuffer<uint32_t>());
 						break;
-					case 'r':
-						writeCharacter<'\r'>();
+					}
+					case etf_type::Small_Big_Ext: {
+						readBytesFromBuffer(static_cast<uint64_t>(readBitsFromBuffer<uint8_t>()) + 1);
 						break;
-					case 't':
-						writeCharacter<'\t'>();
+					}
+					case etf_type::Small_Atom_Ext: {
+						readBytesFromBuffer(readBitsFromBuffer<uint8_t>());
 						break;
+					}
+					case etf_type::Map_Ext: {
+						remaining += static_cast<uint64_t>(readBitsFromBuffer<uint32_t>()) * 2;
+						break;
+					}
+					case etf_type::Small_Tuple_Ext: {
+						remaining += readBitsFromBuffer<uint8_t>();
+						break;
+					}
+					case etf_type::Large_Tuple_Ext: {
+						remaining += readBitsFromBuffer<uint32_t>();
+						break;
+					}
+					case etf_type::Atom_Utf8_Ext: {
+						readBytesFromBuffer(readBitsFromBuffer<uint16_t>());
+						break;
+					}
+					case etf_type::Small_Atom_Utf8_Ext: {
+						readBytesFromBuffer(readBitsFromBuffer<uint8_t>());
+						break;
+					}
+					case etf_type::Large_Big_Ext: {
+						readBytesFromBuffer(static_cast<uint64_t>(readBitsFromBuffer<uint32_t>()) + 1);
+						break;
+					}
 					default: {
-						writeCharacter(stringNew[x]);
+						--offSet;
+						readBytesFromBuffer(valueSize(dataBuffer + offSet, dataSize - offSet));
 						break;
 					}
+				}
+			}
+		}
+
+		/// @brief Assign a sequence of bytes to a string value, reusing its storage where possible.
+		/// @param value The string to assign to.
+		/// @param data Pointer to the bytes to assign.
+		/// @param length The number of bytes to assign.
+		template<string_t value_type> inline void assignString(value_type& value, const char* data, uint64_t length) {
+			if constexpr (has_resize<value_type>) {
+				value.resize(length);
+				if (length) {
+					std::memcpy(value.data(), data, length);
+				}
+			} else {
+				value = value_type{ reinterpret_cast<const typename value_type::value_type*>(data), length };
+			}
+		}
+
+		/// @brief Read an ETF number, converting it to value_type.
+		/// @return The converted value.
+		template<typename value_type> inline value_type readNumber() {
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			switch (static_cast<etf_type>(type)) {
+				case etf_type::Small_Integer_Ext: {
+					return static_cast<value_type>(readBitsFromBuffer<uint8_t>());
+				}
+				case etf_type::Integer_Ext: {
+					return static_cast<value_type>(readBitsFromBuffer<int32_t>());
+				}
+				case etf_type::Small_Big_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Large_Big_Ext: {
+					bool sign{};
+					if constexpr (float_t<value_type>) {
+						const uint64_t digits = static_cast<etf_type>(type) == etf_type::Small_Big_Ext ? readBitsFromBuffer<uint8_t>() : readBitsFromBuffer<uint32_t>();
+						const uint8_t* bytes  = readBigBytes(digits, sign);
+						value_type value{};
+						for (uint64_t x = digits; x-- > 0;) {
+							value = value * 256 + static_cast<value_type>(bytes[x]);
+						}
+						return sign ? -value : value;
+					} else {
+						uint64_t value = readBigMagnitude(static_cast<etf_type>(type), sign);
+						return static_cast<value_type>(sign ? 0 - value : value);
+					}
+				}
+				case etf_type::New_Float_Ext: {
+					uint64_t value = readBitsFromBuffer<uint64_t>();
+					double newDouble{};
+					std::memcpy(&newDouble, &value, sizeof(double));
+					return static_cast<value_type>(newDouble);
+				}
+				case etf_type::Float_Ext: {
+					return static_cast<value_type>(parseFloatText());
+				}
+				case etf_type::Atom_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Atom_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Atom_Utf8_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Atom_Utf8_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Binary_Ext: {
+					auto string = readStringBytes(static_cast<etf_type>(type));
+					value_type value{};
+					if (string == "nil") {
+						return value;
+					}
+					auto result = std::from_chars(string.data(), string.data() + string.size(), value);
+					if (result.ec != std::errc{} || result.ptr != string.data() + string.size()) {
+						throw std::runtime_error{ "etf_parser::readNumber() Error: Expected a number, but found the string: " + std::string{ string } };
+					}
+					return value;
+				}
+				default: {
+					throw std::runtime_error{ "etf_parser::readNumber() Error: Expected a number, but found the type: " + std::to_string(type) };
+				}
+			}
+		}
+
+		/// @brief Parse an ETF boolean atom into a bool.
+		/// @param value The value to parse into.
+		template<bool_t value_type> inline void parseData(value_type& value) {
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			auto string	 = readStringBytes(static_cast<etf_type>(type));
+			if (string == "true") {
+				value = true;
+			} else if (string == "false" || string == "nil") {
+				value = false;
+			} else {
+				throw std::runtime_error{ "etf_parser::parseData() Error: Expected a boolean, but found the atom: " + std::string{ string } };
+			}
+		}
+
+		/// @brief Parse an ETF number into an integer or floating-point value.
+		/// @param value The value to parse into.
+		template<typename value_type>
+			requires(integer_t<value_type> || float_t<value_type>)
+		inline void parseData(value_type& value) {
+			value = readNumber<std::decay_t<value_type>>();
+		}
+
+		/// @brief Parse an ETF integer into an enumerator value.
+		/// @param value The value to parse into.
+		template<enum_t value_type> inline void parseData(value_type& value) {
+			value = static_cast<value_type>(readNumber<std::underlying_type_t<value_type>>());
+		}
+
+		/// @brief Parse an ETF atom, binary, string or number into a string value.
+		/// @param value The value to parse into.
+		template<string_t value_type> inline void parseData(value_type& value) {
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			switch (static_cast<etf_type>(type)) {
+				case etf_type::Atom_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Atom_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Atom_Utf8_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Atom_Utf8_Ext: {
+					auto string = readStringBytes(static_cast<etf_type>(type));
+					if (string == "nil") {
+						return assignString(value, nullptr, 0);
+					}
+					return assignString(value, string.data(), string.size());
+				}
+				case etf_type::String_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Bit_Binary_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Binary_Ext: {
+					auto string = readStringBytes(static_cast<etf_type>(type));
+					if (checkUtf8 && !validateUtf8(reinterpret_cast<const uint8_t*>(string.data()), string.size())) {
+						throw std::runtime_error{ "etf_parser::parseData() Error: Invalid UTF-8 in string." };
+					}
+					return assignString(value, string.data(), string.size());
+				}
+				case etf_type::Nil_Ext: {
+					return assignString(value, nullptr, 0);
+				}
+				case etf_type::Small_Integer_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Integer_Ext: {
+					--offSet;
+					char newBuffer[maxNumberCharSize]{};
+					char* newPtr = toChars(newBuffer, readNumber<int64_t>());
+					return assignString(value, newBuffer, static_cast<uint64_t>(newPtr - newBuffer));
+				}
+				case etf_type::Small_Big_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Large_Big_Ext: {
+					const uint64_t digits = static_cast<etf_type>(type) == etf_type::Small_Big_Ext ? readBitsFromBuffer<uint8_t>() : readBitsFromBuffer<uint32_t>();
+					bool sign{};
+					const uint8_t* bytes = readBigBytes(digits, sign);
+					if (digits > 8) {
+						std::string newString(digits * 3 + maxNumberCharSize, '\0');
+						char* newPtr = newString.data();
+						if (sign) {
+							*newPtr++ = '-';
+						}
+						newPtr = bigToChars(newPtr, bytes, digits, bigScratch);
+						return assignString(value, newString.data(), static_cast<uint64_t>(newPtr - newString.data()));
+					}
+					char newBuffer[maxNumberCharSize]{};
+					char* newPtr = newBuffer;
+					if (sign) {
+						*newPtr++ = '-';
+					}
+					newPtr = toChars(newPtr, loadMagnitude(bytes, digits));
+					return assignString(value, newBuffer, static_cast<uint64_t>(newPtr - newBuffer));
+				}
+				case etf_type::Float_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::New_Float_Ext: {
+					--offSet;
+					char newBuffer[maxNumberCharSize]{};
+					char* newPtr = toChars(newBuffer, readNumber<double>());
+					return assignString(value, newBuffer, static_cast<uint64_t>(newPtr - newBuffer));
+				}
+				default: {
+					throw std::runtime_error{ "etf_parser::parseData() Error: Expected a string, but found the type: " + std::to_string(type) };
+				}
+			}
+		}
+
+		/// @brief Assign one element of a String_Ext, which ETF uses for lists of small integers.
+		/// @param value The element to assign to.
+		/// @param byte The element's value.
+		template<typename value_type> inline void parseByte(value_type& value, uint8_t byte) {
+			if constexpr (integer_t<value_type> || float_t<value_type> || enum_t<value_type>) {
+				value = static_cast<value_type>(byte);
+			} else {
+				throw std::runtime_error{ "etf_parser::parseByte() Error: Expected a list of numbers, but found a String_Ext." };
+			}
+		}
+
+		/// @brief Parse an ETF list into a resizable array value.
+		/// @param value The value to parse into.
+		template<array_t value_type> inline void parseData(value_type& value) {
+			if (readNilAtom()) {
+				value.resize(0);
+				return;
+			}
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			switch (static_cast<etf_type>(type)) {
+				case etf_type::List_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Tuple_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Large_Tuple_Ext: {
+					uint32_t length = readSequenceLength(static_cast<etf_type>(type));
+					if (static_cast<uint64_t>(offSet) + length > dataSize) {
+						throw std::out_of_range{ "etf_parser::parseData() Error: Read past end of buffer." };
+					}
+					value.resize(length);
+					for (uint32_t x = 0; x < length; ++x) {
+						parseData(value[x]);
+					}
+					if (static_cast<etf_type>(type) == etf_type::List_Ext) {
+						skipValue();
+					}
+					return;
+				}
+				case etf_type::String_Ext: {
+					auto string = readStringBytes(etf_type::String_Ext);
+					value.resize(string.size());
+					for (uint64_t x = 0; x < string.size(); ++x) {
+						parseByte(value[x], static_cast<uint8_t>(string[x]));
+					}
+					return;
+				}
+				case etf_type::Nil_Ext: {
+					value.resize(0);
+					return;
+				}
+				default: {
+					throw std::runtime_error{ "etf_parser::parseData() Error: Expected a list, but found the type: " + std::to_string(type) };
+				}
+			}
+		}
+
+		/// @brief Parse an ETF list into a fixed-size array value, skipping any elements beyond its size.
+		/// @param value The value to parse into.
+		template<fixed_array_t value_type> inline void parseData(value_type& value) {
+			constexpr uint64_t maxSize{ std::tuple_size_v<std::decay_t<value_type>> };
+			if (readNilAtom()) {
+				return;
+			}
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			switch (static_cast<etf_type>(type)) {
+				case etf_type::List_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Tuple_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Large_Tuple_Ext: {
+					uint32_t length = readSequenceLength(static_cast<etf_type>(type));
+					for (uint32_t x = 0; x < length; ++x) {
+						if (x < maxSize) {
+							parseData(value[x]);
+						} else {
+							skipValue();
+						}
+					}
+					if (static_cast<etf_type>(type) == etf_type::List_Ext) {
+						skipValue();
+					}
+					return;
+				}
+				case etf_type::String_Ext: {
+					auto string = readStringBytes(etf_type::String_Ext);
+					for (uint64_t x = 0; x < string.size() && x < maxSize; ++x) {
+						parseByte(value[x], static_cast<uint8_t>(string[x]));
 					}
-					break;
+					return;
 				}
-				case '"': {
-					writeCharacter<'\\'>();
-					writeCharacter<'\"'>();
-					break;
+				case etf_type::Nil_Ext: {
+					return;
 				}
 				default: {
-					writeCharacter(stringNew[x]);
-					break;
-				}
+					throw std::runtime_error{ "etf_parser::parseData() Error: Expected a list, but found the type: " + std::to_string(type) };
 				}
 			}
-			writeCharacter<'"'>();
 		}
 
-		/// @brief Write a character to the final JSON string.
-		/// @param value The character to write.
-		inline void writeCharacter(const char value) {
-			if (finalString.size() < currentSize + 1) {
-				finalString.resize((finalString.size() + 1) * 2);
-			}
-			finalString[currentSize++] = value;
+		/// @brief Read the number of elements of a list or tuple, whose tag has already been consumed.
+		/// @param type The type of the value.
+		/// @return The number of elements.
+		inline uint32_t readSequenceLength(etf_type type) {
+			return type == etf_type::Small_Tuple_Ext ? readBitsFromBuffer<uint8_t>() : readBitsFromBuffer<uint32_t>();
 		}
 
-		/// @brief Write a character to the final JSON string.
-		/// @tparam value The character to write.
-		template<const char charToWrite> inline void writeCharacter() {
-			if (finalString.size() < currentSize + 1) {
-				finalString.resize((finalString.size() + 1) * 2);
+		/// @brief Parse an ETF tuple or list into a std::pair or std::tuple, skipping any elements beyond its size.
+		/// @param value The value to parse into.
+		template<tuple_t value_type> inline void parseData(value_type& value) {
+			constexpr uint64_t maxSize{ std::tuple_size_v<std::decay_t<value_type>> };
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			switch (static_cast<etf_type>(type)) {
+				case etf_type::List_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Small_Tuple_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Large_Tuple_Ext: {
+					const uint32_t length = readSequenceLength(static_cast<etf_type>(type));
+					[&]<uint64_t... indices>(std::index_sequence<indices...>) {
+						((indices < length ? parseData(std::get<indices>(value)) : void()), ...);
+					}(std::make_index_sequence<maxSize>{});
+					for (uint64_t x = maxSize; x < length; ++x) {
+						skipValue();
+					}
+					if (static_cast<etf_type>(type) == etf_type::List_Ext) {
+						skipValue();
+					}
+					return;
+				}
+				case etf_type::Nil_Ext: {
+					return;
+				}
+				default: {
+					throw std::runtime_error{ "etf_parser::parseData() Error: Expected a tuple, but found the type: " + std::to_string(type) };
+				}
 			}
-			finalString[currentSize++] = charToWrite;
 		}
 
-		/// @brief Parse a single ETF value and convert to JSON.
-		void singleValueETFToJson() {
-			if (offSet > dataSize) {
-				throw std::out_of_range{ "etf_parser::singleValueETFToJson() Error: Read past end of buffer." };
-			}
-			uint8_t type = readBitsFromBuffer<int8_t>();
-			switch (static_cast<etf_type>(type)) {
-			case etf_type::New_Float_Ext: {
-				return parseNewFloatExt();
-			}
-			case etf_type::Small_Integer_Ext: {
-				return parseSmallIntegerExt();
-			}
-			case etf_type::Integer_Ext: {
-				return parseIntegerExt();
-			}
-			case etf_type::Atom_Ext: {
-				return parseAtomExt();
-			}
-			case etf_type::Nil_Ext: {
-				return parseNilExt();
-			}
-			case etf_type::String_Ext: {
-				return parseStringExt();
-			}
-			case etf_type::List_Ext: {
-				return parseListExt();
-			}
-			case etf_type::Binary_Ext: {
-				return parseBinaryExt();
-			}
-			case etf_type::Small_Big_Ext: {
-				return parseSmallBigExt();
-			}
-			case etf_type::Small_Atom_Ext: {
-				return parseSmallAtomExt();
-			}
-			case etf_type::Map_Ext: {
-				return parseMapExt();
-			}
-			default: {
-				throw std::runtime_error{ "etf_parser::singleValueETFToJson() Error: Unknown data type in ETF, the type: " + std::to_string(type) };
-			}
+		/// @brief Parse an ETF atom or binary into an interned key, which must have been interned already, so that data from a peer cannot
+		/// grow the process-wide key table.
+		/// @param value The value to parse into.
+		template<interned_key_t value_type> inline void parseData(value_type& value) {
+			if (!parseKnownKey(value)) {
+				throw std::runtime_error{ "etf_parser::parseData() Error: Found a key that has not been interned." };
 			}
 		}
 
-		/// @brief Parse ETF data representing a list and convert to JSON array.
-		inline void parseListExt() {
-			uint32_t length = readBitsFromBuffer<uint32_t>();
-			writeCharacter<'['>();
-			if (static_cast<uint64_t>(offSet) + length > dataSize) {
-				throw std::out_of_range{ "etf_parser::parseListExt() Error: Read past end of buffer." };
+		/// @brief Parse an ETF atom or binary into an interned key, looking it up without interning it.
+		/// @param value The value to parse into, which is left unchanged if the key has not been interned.
+		/// @return True if the key had been interned, false otherwise.
+		template<interned_key_t value_type> inline bool parseKnownKey(value_type& value) {
+			const etf_type type = peekType();
+			if (!isKeyType(type)) {
+				throw std::runtime_error{ "etf_parser::parseData() Error: Expected a key, but found the type: " + std::to_string(static_cast<uint32_t>(type)) };
 			}
-			for (uint16_t x = 0; x < length; ++x) {
-				singleValueETFToJson();
-				if (x < length - 1) {
-					writeCharacter<','>();
-				}
+			++offSet;
+			if (auto key = value_type::find(readStringBytes(type))) {
+				value = *key;
+				return true;
 			}
-			readBitsFromBuffer<uint8_t>();
-			writeCharacter<']'>();
-		}
-
-		/// @brief Parse ETF data representing a small integer and convert to JSON number.
-		inline void parseSmallIntegerExt() {
-			auto string = std::to_string(readBitsFromBuffer<uint8_t>());
-			writeCharacters(string.data(), string.size());
-		}
-
-		/// @brief Parse ETF data representing an integer and convert to JSON number.
-		inline void parseIntegerExt() {
-			auto string = std::to_string(readBitsFromBuffer<uint32_t>());
-			writeCharacters(string.data(), string.size());
+			return false;
 		}
 
-		/// @brief Parse ETF data representing a string and convert to JSON string.
-		inline void parseStringExt() {
-			writeCharacter<'"'>();
-			uint16_t length = readBitsFromBuffer<uint16_t>();
-			if (static_cast<uint64_t>(offSet) + length > dataSize) {
-				throw std::out_of_range{ "etf_parser::parseStringExt() Error: Read past end of buffer." };
+		/// @brief Parse an ETF map into an associative container.
+		/// @param value The value to parse into.
+		template<object_t value_type> inline void parseData(value_type& value) {
+			value.clear();
+			if (readNilAtom()) {
+				return;
 			}
-			for (uint16_t x = 0; x < length; ++x) {
-				parseSmallIntegerExt();
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			if (static_cast<etf_type>(type) != etf_type::Map_Ext) {
+				throw std::runtime_error{ "etf_parser::parseData() Error: Expected a map, but found the type: " + std::to_string(type) };
+			}
+			uint32_t length = readBitsFromBuffer<uint32_t>();
+			for (uint32_t x = 0; x < length; ++x) {
+				typename value_type::key_type key{};
+				if constexpr (interned_key_t<typename value_type::key_type>) {
+					if (!parseKnownKey(key)) {
+						skipValue();
+						continue;
+					}
+				} else {
+					parseData(key);
+				}
+				parseData(value[std::move(key)]);
 			}
-			writeCharacter<'"'>();
-		}
-
-		/// @brief Parse ETF data representing a new float and convert to JSON number.
-		inline void parseNewFloatExt() {
-			uint64_t value = readBitsFromBuffer<uint64_t>();
-			double newDouble{};
-			std::memcpy(&newDouble, &value, sizeof(double));
-			std::string valueNew = std::to_string(newDouble);
-			writeCharacters(valueNew.data(), valueNew.size());
 		}
 
-		/// @brief Parse ETF data representing a small big integer and convert to JSON number.
-		inline void parseSmallBigExt() {
-			writeCharacter<'"'>();
-			auto digits = readBitsFromBuffer<uint8_t>();
-			uint8_t sign = readBitsFromBuffer<uint8_t>();
-
-
-			if (digits > 8) {
-				throw std::runtime_error{ "etf_parser::parseSmallBigExt() Error: Big integers larger than 8 bytes not supported." };
+		/// @brief Parse an ETF value into an optional, resetting it if the value is nil.
+		/// @param value The value to parse into.
+		template<optional_t value_type> inline void parseData(value_type& value) {
+			if (readNilAtom()) {
+				value.reset();
+				return;
 			}
-
-			uint64_t value = 0;
-			uint64_t bits = 1;
-			for (uint8_t x = 0; x < digits; ++x) {
-				uint64_t digit = readBitsFromBuffer<uint8_t>();
-				value += digit * bits;
-				bits <<= 8;
+			if (!value.has_value()) {
+				value.emplace();
 			}
+			parseData(*value);
+		}
 
-			if (sign == 0) {
-				auto string = std::to_string(value);
-				writeCharacters(string.data(), string.size());
-				writeCharacter<'"'>();
+		/// @brief Parse an ETF map into a type described by core<value_type>, skipping any unknown keys.
+		/// @param value The value to parse into.
+		template<core_t value_type> inline void parseData(value_type& value) {
+			if (readNilAtom()) {
+				return;
 			}
-			else {
-				auto string = std::to_string(-(static_cast<int64_t>(value)));
-				writeCharacters(string.data(), string.size());
-				writeCharacter<'"'>();
+			uint8_t type = readBitsFromBuffer<uint8_t>();
+			if (static_cast<etf_type>(type) != etf_type::Map_Ext) {
+				throw std::runtime_error{ "etf_parser::parseData() Error: Expected a map, but found the type: " + std::to_string(type) };
 			}
-		}
-
-		/// @brief Parse ETF data representing an atom and convert to JSON string.
-		inline void parseAtomExt() {
-			writeCharactersFromBuffer(readBitsFromBuffer<uint16_t>());
-		}
-
-		/// @brief Parse ETF data representing a binary and convert to JSON string.
-		inline void parseBinaryExt() {
-			writeCharactersFromBuffer(readBitsFromBuffer<uint32_t>());
-		}
-
-		/// @brief Parse ETF data representing a nil value and convert to JSON null.
-		inline void parseNilExt() {
-			writeCharacters("[]", 2);
-		}
-
-		/// @brief Parse ETF data representing a small atom and convert to JSON string.
-		inline void parseSmallAtomExt() {
-			writeCharactersFromBuffer(readBitsFromBuffer<uint8_t>());
-		}
-
-		/// @brief Parse ETF data representing a map and convert to JSON object.
-		inline void parseMapExt() {
 			uint32_t length = readBitsFromBuffer<uint32_t>();
-			writeCharacter<'{'>();
 			for (uint32_t x = 0; x < length; ++x) {
-				singleValueETFToJson();
-				writeCharacter<':'>();
-				singleValueETFToJson();
-				if (x < length - 1) {
-					writeCharacter<','>();
+				auto keyType = peekType();
+				if (!isKeyType(keyType)) {
+					skipValue();
+					skipValue();
+					continue;
+				}
+				++offSet;
+				if (!parseField(value, readStringBytes(keyType))) {
+					skipValue();
 				}
 			}
-			writeCharacter<'}'>();
+		}
+
+		/// @brief Find the field of core<value_type> that matches a key through fieldHashTable, and parse the next value into it.
+		/// @param value The value whose field is to be parsed into.
+		/// @param key The key of the field.
+		/// @return True if a matching field was found, false otherwise.
+		template<core_t value_type> inline bool parseField(value_type& value, std::string_view key) {
+			using field_parser = void (*)(etf_parser&, value_type&);
+			static constexpr auto fieldParsers = []<uint64_t... indices>(std::index_sequence<indices...>) {
+				return std::array<field_parser, sizeof...(indices)>{ [](etf_parser& parser, value_type& valueNew) {
+					parser.parseData(valueNew.*std::get<indices>(core<value_type>::parseValue).memberPtr);
+				}... };
+			}(std::make_index_sequence<fieldCount<value_type>>{});
+			const uint64_t index = fieldHashTable<value_type>.find(key);
+			if (index == fieldCount<value_type>) {
+				return false;
+			}
+			fieldParsers[index](*this, value);
+			return true;
 		}
 	};
 
 	/// @brief Enumeration for different JSON value types.
 	enum class json_type : uint8_t { null_t = 0, object_t = 1, array_t = 2, string_t = 3, float_t = 4, uint_t = 5, int_t = 6, bool_t = 7 };
 
+	struct etf_constant_encoder;
+	struct etf_json_transcoder;
+
 	/// @brief Class for serializing data into the ETF format.
+	/// Every node, along with its maps, vectors and strings, is allocated from the std::pmr::memory_resource that it was constructed with,
+	/// which children inherit. Passing a std::pmr::monotonic_buffer_resource lets a whole tree be built from one arena and released at once.
+	/// Object keys are interned_keys, so each distinct key is stored once per process rather than once per object.
 	class etf_serializer {
 	  public:		
-		template<typename value_type> using allocator = std::allocator<value_type>;
+		template<typename value_type> using allocator = std::pmr::polymorphic_allocator<value_type>;
 		template<typename value_type> using allocator_traits = std::allocator_traits<allocator<value_type>>;
-		using object_type = std::unordered_map<std::string, etf_serializer>;
-		using array_type = std::vector<etf_serializer>;
-		using string_type = std::string;
+		using allocator_type = allocator<etf_serializer>;
+		using object_type = flat_map<interned_key, etf_serializer>;
+
+		friend struct etf_constant_encoder;
+		friend struct etf_json_transcoder;
+		using array_type = std::pmr::vector<etf_serializer>;
+		using string_type = std::pmr::string;
 		using float_type = double;
 		using uint_type = uint64_t;
 		using int_type = int64_t;
@@ -451,10 +1739,18 @@ namespace CppEtfer {
 		/// @brief Default constructor.
 		inline etf_serializer() = default;
 
-		/// @brief Move assignment operator.
+		/// @brief Constructor for allocating from a specific memory resource.
+		/// @param alloc The allocator that this object and all of its children allocate from.
+		inline explicit etf_serializer(const allocator_type& alloc) : resource{ alloc.resource() } {
+		}
+
+		/// @brief Move assignment operator, which copies instead if data allocates from a different memory resource.
 		/// @param data The data to be moved into this object.
 		/// @return A reference to this object after the move.
-		inline etf_serializer& operator=(etf_serializer&& data) noexcept {
+		inline etf_serializer& operator=(etf_serializer&& data) {
+			if (*resource != *data.resource) {
+				return *this = static_cast<const etf_serializer&>(data);
+			}
 			destroyImpl();
 			stringReal = std::move(data.stringReal);
 			type	   = data.type;
@@ -504,7 +1800,14 @@ namespace CppEtfer {
 
 		/// @brief Move constructor.
 		/// @param data The data to be moved into this object.
-		inline etf_serializer(etf_serializer&& data) noexcept {
+		inline etf_serializer(etf_serializer&& data) noexcept : resource{ data.resource } {
+			*this = std::move(data);
+		}
+
+		/// @brief Move constructor for allocating from a specific memory resource.
+		/// @param data The data to be moved into this object.
+		/// @param alloc The allocator that this object and all of its children allocate from.
+		inline etf_serializer(etf_serializer&& data, const allocator_type& alloc) : resource{ alloc.resource() } {
 			*this = std::move(data);
 		}
 
@@ -512,6 +1815,9 @@ namespace CppEtfer {
 		/// @param data The data to be copied into this object.
 		/// @return A reference to this object after the copy.
 		inline etf_serializer& operator=(const etf_serializer& data) {
+			if (this == &data) {
+				return *this;
+			}
 			destroyImpl();
 			switch (data.type) {
 				case json_type::object_t: {
@@ -546,7 +1852,6 @@ namespace CppEtfer {
 					break;
 				}
 			}
-			stringReal = data.stringReal;
 			return *this;
 		}
 
@@ -556,6 +1861,13 @@ namespace CppEtfer {
 			*this = data;
 		}
 
+		/// @brief Copy constructor for allocating from a specific memory resource.
+		/// @param data The data to be copied into this object.
+		/// @param alloc The allocator that this object and all of its children allocate from.
+		inline etf_serializer(const etf_serializer& data, const allocator_type& alloc) : resource{ alloc.resource() } {
+			*this = data;
+		}
+
 		/// @brief Template operator= overload for assigning values of string type.
 		/// @tparam value_type The type of value to assign.
 		/// @param data The data to be assigned.
@@ -719,25 +2031,110 @@ namespace CppEtfer {
 			*this = data;
 		}
 
+		/// @brief Serialize a value directly into ETF, without building an etf_serializer tree.
+		/// @tparam value_type The type to serialize, user-defined types are described by a core<value_type> specialization.
+		/// @tparam buffer_type The type of the output buffer, a contiguous container of bytes.
+		/// @param value The value to be serialized.
+		/// @param buffer The buffer to write the ETF data into, its previous contents are replaced.
+		template<typename value_type, typename buffer_type> inline static void serializeToEtf(const value_type& value, buffer_type& buffer) {
+			buffer.clear();
+			appendToEtf(value, buffer);
+		}
+
+		/// @brief Serialize a value directly into ETF onto the end of a buffer, without building an etf_serializer tree.
+		/// @tparam value_type The type to serialize, user-defined types are described by a core<value_type> specialization.
+		/// @tparam buffer_type The type of the output buffer, a contiguous container of bytes.
+		/// @param value The value to be serialized.
+		/// @param buffer The buffer to append the ETF data to, its previous contents are kept.
+		template<typename value_type, typename buffer_type> inline static void appendToEtf(const value_type& value, buffer_type& buffer) {
+			const frame_timer timer{};
+			const uint64_t oldSize = buffer.size();
+			writeBytes(buffer, &formatVersion, 1);
+			writeData(buffer, value);
+			timer.finish(etf_frame_kind::serialize, 0, buffer.size() - oldSize);
+		}
+
 		/// @brief Get the JSON type of this object.
 		/// @return The JSON type of this object.
 		inline json_type getType() const {
 			return type;
 		}
 
+		/// @brief Get the allocator that this object and all of its children allocate from.
+		/// @return The allocator.
+		inline allocator_type get_allocator() const {
+			return allocator_type{ resource };
+		}
+
 		/// @brief Conversion operator to std::basic_string<uint8_t>.
 		/// @return A UTF-8 string representation of this object.
-		inline operator std::basic_string<uint8_t>() {
+		inline operator std::basic_string<uint8_t>() const {
+			return serialize(defaultMaxDepth);
+		}
+
+		/// @brief Serialize this object to ETF, limiting how deeply its objects and arrays may be nested.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		/// @return The ETF representation of this object.
+		inline std::basic_string<uint8_t> serialize(uint64_t maxDepth) const {
+			std::basic_string<uint8_t> newString{};
+			serializeAppend(newString, maxDepth);
+			return newString;
+		}
+
+		/// @brief Compute the exact number of bytes that this object serializes to, including the format version.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		/// @return The size of the ETF representation of this object.
+		inline uint64_t serializedSize(uint64_t maxDepth = defaultMaxDepth) const {
+			size_writer writer{ 1 };
+			serializeJsonToEtfString(writer, *this, maxDepth);
+			return writer.size;
+		}
+
+		/// @brief Serialize this object to ETF into a caller-supplied buffer, without allocating.
+		/// @param buffer The buffer to serialize into, which must hold at least serializedSize() bytes.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		/// @return The number of bytes written.
+		inline uint64_t serializeTo(std::span<uint8_t> buffer, uint64_t maxDepth = defaultMaxDepth) const {
+			const frame_timer timer{};
+			const uint64_t size = serializedSize(maxDepth);
+			if (size > buffer.size()) {
+				throw std::runtime_error{ "etf_serializer::serializeTo() Error: The buffer holds " + std::to_string(buffer.size()) + " bytes, but " +
+					std::to_string(size) + " are needed." };
+			}
+			const uint64_t depth = writeSized(buffer.data(), maxDepth);
+			timer.finish(etf_frame_kind::serialize, 0, size, depth);
+			return size;
+		}
+
+		/// @brief Serialize this object to ETF, appending to the end of a buffer, which is grown exactly once.
+		/// With an uninitialized_buffer the appended bytes are not zero-filled before being written.
+		/// @tparam buffer_type The type of the buffer, which must provide size(), resize() and data() over bytes.
+		/// @param buffer The buffer to append to.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		template<typename buffer_type> inline void serializeAppend(buffer_type& buffer, uint64_t maxDepth = defaultMaxDepth) const {
+			const frame_timer timer{};
+			const uint64_t oldSize = buffer.size();
+			buffer.resize(oldSize + serializedSize(maxDepth));
+			const uint64_t depth = writeSized(reinterpret_cast<uint8_t*>(buffer.data()) + oldSize, maxDepth);
+			timer.finish(etf_frame_kind::serialize, 0, buffer.size() - oldSize, depth);
+		}
+
+		/// @brief Serialize this object to ETF into a buffer that this object keeps and reuses, so that repeated calls stop allocating once
+		/// the buffer has grown to fit.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		/// @return The ETF representation of this object, valid until the next call or until this object is modified or destroyed.
+		inline std::span<const uint8_t> serializeToBuffer(uint64_t maxDepth = defaultMaxDepth) {
+			const uint64_t oldCapacity = stringReal.capacity();
 			stringReal.clear();
-			appendVersion();
-			serializeJsonToEtfString(*this);
-			return stringReal;
+			serializeAppend(stringReal, maxDepth);
+			recordBufferGrowth(etf_frame_kind::serialize, oldCapacity, stringReal.capacity());
+			return std::span<const uint8_t>{ stringReal.data(), stringReal.size() };
 		}
 
 		/// @brief Operator[] overload for accessing object elements by key.
 		/// @param key The key to access.
 		/// @return A reference to the element with the specified key.
-		inline etf_serializer& operator[](const typename object_type::key_type& key) {
+		inline etf_serializer& operator[](std::string_view key) {
 			if (type == json_type::null_t) {
 				setValue<json_type::object_t>();
 			}
@@ -935,165 +2332,471 @@ namespace CppEtfer {
 		}
 
 	  protected:
-		std::basic_string<uint8_t> stringReal{};///< The string that stores the serialized JSON.
+		uninitialized_buffer<uint8_t> stringReal{};///< The buffer that serializeToBuffer() reuses between calls.
+		std::pmr::memory_resource* resource{ std::pmr::get_default_resource() };///< The memory resource that the stored value is allocated from.
 		json_type type{ json_type::null_t };///< The JSON type stored in the etf_serializer.
 		union {
-			std::unordered_map<std::string, etf_serializer>* objectValue;///< Pointer to the stored object.
-			std::vector<etf_serializer>* arrayValue;///< Pointer to the stored array.
-			std::string* stringValue;///< Pointer to the stored string.
+			object_type* objectValue;///< Pointer to the stored object.
+			array_type* arrayValue;///< Pointer to the stored array.
+			string_type* stringValue;///< Pointer to the stored string.
 			double* floatValue;///< Pointer to the stored float.
 			uint64_t* uintValue;///< Pointer to the stored unsigned integer.
 			int64_t* intValue;///< Pointer to the stored signed integer.
 			bool* boolValue;///< Pointer to the stored boolean.
 		};
 
+		/// @brief The precomputed Binary_Ext header and name bytes of a field of core<value_type>.
+		template<core_t value_type, uint64_t index> static constexpr auto fieldKey{ [] {
+			constexpr auto name = std::get<index>(core<value_type>::parseValue).name;
+			std::array<uint8_t, name.size() + 5> newBuffer{ static_cast<uint8_t>(etf_type::Binary_Ext), static_cast<uint8_t>(name.size() >> 24),
+				static_cast<uint8_t>(name.size() >> 16), static_cast<uint8_t>(name.size() >> 8), static_cast<uint8_t>(name.size()) };
+			for (uint64_t x = 0; x < name.size(); ++x) {
+				newBuffer[x + 5] = static_cast<uint8_t>(name[x]);
+			}
+			return newBuffer;
+		}() };
+
+		/// @brief The precomputed Map_Ext header of core<value_type>.
+		template<core_t value_type> static constexpr std::array<uint8_t, 5> mapHeader{ static_cast<uint8_t>(etf_type::Map_Ext), static_cast<uint8_t>(fieldCount<value_type> >> 24),
+			static_cast<uint8_t>(fieldCount<value_type> >> 16), static_cast<uint8_t>(fieldCount<value_type> >> 8), static_cast<uint8_t>(fieldCount<value_type>) };
+
+		/// @brief Append a sequence of bytes to a buffer.
+		/// @param buffer The buffer to append to.
+		/// @param data A pointer to the data to be written.
+		/// @param length The length of the data.
+		template<typename buffer_type> inline static void writeBytes(buffer_type& buffer, const void* data, uint64_t length) {
+			auto newPtr = static_cast<const typename buffer_type::value_type*>(data);
+			if constexpr (requires { buffer.append(newPtr, length); }) {
+				buffer.append(newPtr, length);
+			} else {
+				buffer.insert(buffer.end(), newPtr, newPtr + length);
+			}
+		}
+
+		/// @brief Append a tag followed by a big-endian length to a buffer.
+		/// @param buffer The buffer to append to.
+		/// @param type The ETF tag.
+		/// @param length The length to be stored after the tag.
+		template<typename buffer_type> inline static void writeHeader(buffer_type& buffer, etf_type type, uint32_t length) {
+			uint8_t newBuffer[5]{ static_cast<uint8_t>(type) };
+			storeBits(newBuffer + 1, length);
+			writeBytes(buffer, newBuffer, std::size(newBuffer));
+		}
+
+		/// @brief Serialize a boolean as an atom.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, bool_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			static constexpr uint8_t trueBuffer[6]{ static_cast<uint8_t>(etf_type::Small_Atom_Ext), 4, 't', 'r', 'u', 'e' };
+			static constexpr uint8_t falseBuffer[7]{ static_cast<uint8_t>(etf_type::Small_Atom_Ext), 5, 'f', 'a', 'l', 's', 'e' };
+			if (value) {
+				writeBytes(buffer, trueBuffer, std::size(trueBuffer));
+			} else {
+				writeBytes(buffer, falseBuffer, std::size(falseBuffer));
+			}
+		}
+
+		/// @brief Serialize an integer as the smallest ETF integer type that holds it.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, integer_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			if (value >= 0 && static_cast<uint64_t>(value) <= std::numeric_limits<uint8_t>::max()) {
+				uint8_t newBuffer[2]{ static_cast<uint8_t>(etf_type::Small_Integer_Ext), static_cast<uint8_t>(value) };
+				writeBytes(buffer, newBuffer, std::size(newBuffer));
+			} else if (std::in_range<int32_t>(value)) {
+				uint8_t newBuffer[5]{ static_cast<uint8_t>(etf_type::Integer_Ext) };
+				storeBits(newBuffer + 1, static_cast<int32_t>(value));
+				writeBytes(buffer, newBuffer, std::size(newBuffer));
+			} else {
+				uint8_t newBuffer[11]{ static_cast<uint8_t>(etf_type::Small_Big_Ext) };
+				uint64_t magnitude = static_cast<uint64_t>(value);
+				if constexpr (signed_t<value_type>) {
+					if (value < 0) {
+						newBuffer[2] = 1;
+						magnitude	 = 0 - magnitude;
+					}
+				}
+				uint8_t encodedBytes{};
+				while (magnitude > 0) {
+					newBuffer[3 + encodedBytes] = static_cast<uint8_t>(magnitude & 0xFF);
+					magnitude >>= 8;
+					++encodedBytes;
+				}
+				newBuffer[1] = encodedBytes;
+				writeBytes(buffer, newBuffer, 3ull + static_cast<uint64_t>(encodedBytes));
+			}
+		}
+
+		/// @brief Serialize a floating-point value as a New_Float_Ext.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, float_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			uint8_t newBuffer[9]{ static_cast<uint8_t>(etf_type::New_Float_Ext) };
+			storeBits(newBuffer + 1, std::bit_cast<uint64_t>(static_cast<double>(value)));
+			writeBytes(buffer, newBuffer, std::size(newBuffer));
+		}
+
+		/// @brief Serialize an enumerator as its underlying integer.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, enum_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			writeData(buffer, static_cast<std::underlying_type_t<value_type>>(value));
+		}
+
+		/// @brief Serialize a string as a Binary_Ext.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, string_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			writeHeader(buffer, etf_type::Binary_Ext, static_cast<uint32_t>(value.size()));
+			writeBytes(buffer, value.data(), value.size());
+		}
+
+		/// @brief Serialize an interned key as a Binary_Ext.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, interned_key_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			writeData(buffer, value.view());
+		}
+
+		/// @brief Serialize a null value as the atom nil.
+		/// @param buffer The buffer to append to.
+		template<typename buffer_type, null_t value_type> inline static void writeData(buffer_type& buffer, const value_type&) {
+			static constexpr uint8_t nilBuffer[5]{ static_cast<uint8_t>(etf_type::Small_Atom_Ext), 3, 'n', 'i', 'l' };
+			writeBytes(buffer, nilBuffer, std::size(nilBuffer));
+		}
+
+		/// @brief Serialize an array as a List_Ext, or a Nil_Ext if it is empty.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, typename value_type>
+			requires(array_t<value_type> || fixed_array_t<value_type>)
+		inline static void writeData(buffer_type& buffer, const value_type& value) {
+			if (value.size() > 0) {
+				writeHeader(buffer, etf_type::List_Ext, static_cast<uint32_t>(value.size()));
+				for (auto& valueNew: value) {
+					writeData(buffer, valueNew);
+				}
+			}
+			uint8_t newBuffer[1]{ static_cast<uint8_t>(etf_type::Nil_Ext) };
+			writeBytes(buffer, newBuffer, std::size(newBuffer));
+		}
+
+		/// @brief Serialize a std::pair or std::tuple as a Small_Tuple_Ext, or a Large_Tuple_Ext if it has more than 255 elements.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, tuple_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			constexpr uint64_t size{ std::tuple_size_v<std::decay_t<value_type>> };
+			if constexpr (size > std::numeric_limits<uint8_t>::max()) {
+				writeHeader(buffer, etf_type::Large_Tuple_Ext, static_cast<uint32_t>(size));
+			} else {
+				uint8_t newBuffer[2]{ static_cast<uint8_t>(etf_type::Small_Tuple_Ext), static_cast<uint8_t>(size) };
+				writeBytes(buffer, newBuffer, std::size(newBuffer));
+			}
+			[&]<uint64_t... indices>(std::index_sequence<indices...>) {
+				(writeData(buffer, std::get<indices>(value)), ...);
+			}(std::make_index_sequence<size>{});
+		}
+
+		/// @brief Serialize an associative container as a Map_Ext.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, object_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			writeHeader(buffer, etf_type::Map_Ext, static_cast<uint32_t>(value.size()));
+			for (auto& [key, valueNew]: value) {
+				writeData(buffer, key);
+				writeData(buffer, valueNew);
+			}
+		}
+
+		/// @brief Serialize an optional as its value, or the atom nil if it is empty.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, optional_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			if (value.has_value()) {
+				writeData(buffer, *value);
+			} else {
+				writeData(buffer, nullptr);
+			}
+		}
+
+		/// @brief Serialize a type described by core<value_type> as a Map_Ext.
+		/// @param buffer The buffer to append to.
+		/// @param value The value to be serialized.
+		template<typename buffer_type, core_t value_type> inline static void writeData(buffer_type& buffer, const value_type& value) {
+			writeBytes(buffer, mapHeader<value_type>.data(), mapHeader<value_type>.size());
+			[&]<uint64_t... indices>(std::index_sequence<indices...>) {
+				(writeField<indices>(buffer, value), ...);
+			}(std::make_index_sequence<fieldCount<value_type>>{});
+		}
+
+		/// @brief Serialize a single field of a type described by core<value_type>.
+		/// @tparam index The index of the field.
+		/// @param buffer The buffer to append to.
+		/// @param value The value whose field is to be serialized.
+		template<uint64_t index, typename buffer_type, core_t value_type> inline static void writeField(buffer_type& buffer, const value_type& value) {
+			static constexpr auto field = std::get<index>(core<value_type>::parseValue);
+			writeBytes(buffer, fieldKey<value_type, index>.data(), fieldKey<value_type, index>.size());
+			writeData(buffer, value.*field.memberPtr);
+		}
+
+		/// @brief Writer that only counts the bytes that would be written.
+		struct size_writer {
+			uint64_t size{};///< The number of bytes counted so far.
+
+			constexpr void write(const void*, uint64_t length) {
+				size += length;
+			}
+		};
+
+		/// @brief Writer that copies into storage which has already been sized to fit, without bounds checks.
+		struct pointer_writer {
+			uint8_t* currentPtr{};///< Pointer to the next byte to be written.
+
+			inline void write(const void* data, uint64_t length) {
+				std::memcpy(currentPtr, data, length);
+				currentPtr += length;
+			}
+		};
+
+		/// @brief Serialize this object, including the format version, into storage of at least serializedSize() bytes.
+		/// @param newPtr Pointer to the storage.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		/// @return The deepest nesting reached, only tracked when instrumentationEnabled is true.
+		inline uint64_t writeSized(uint8_t* newPtr, uint64_t maxDepth) const {
+			pointer_writer writer{ newPtr };
+			appendVersion(writer);
+			return serializeJsonToEtfString(writer, *this, maxDepth);
+		}
+
+		/// @brief An object or array whose elements are still being serialized.
+		struct serialize_frame {
+			const etf_serializer* value{};///< The object or array.
+			uint64_t index{};///< The index of the next element to serialize.
+		};
+
+		/// @brief Get the stack of objects and arrays being serialized, which is reused between calls on the same thread.
+		/// @return A reference to the stack.
+		inline static std::vector<serialize_frame>& serializeStack() {
+			thread_local std::vector<serialize_frame> stack{};
+			return stack;
+		}
+
 		/// @brief Serialize an etf_serializer object to an ETF string.
+		/// Objects and arrays are tracked on an explicit stack instead of by recursion, so the nesting depth is bounded by maxDepth rather
+		/// than by the size of the call stack.
+		/// @param writer The writer to append to.
+		/// @param dataToParse The etf_serializer object to be serialized.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		/// @return The deepest nesting reached, only tracked when instrumentationEnabled is true.
+		template<typename writer_type> inline static uint64_t serializeJsonToEtfString(writer_type& writer, const etf_serializer& dataToParse, uint64_t maxDepth) {
+			auto& stack = serializeStack();
+			const uint64_t baseSize = stack.size();
+			const etf_serializer* current = &dataToParse;
+			uint64_t deepest{};
+			while (current) {
+				if (recordEtfValue(writer, *current)) {
+					if (stack.size() - baseSize >= maxDepth) {
+						stack.resize(baseSize);
+						throw std::runtime_error{ "etf_serializer::serializeJsonToEtfString() Error: Exceeded the maximum nesting depth of " + std::to_string(maxDepth) + "." };
+					}
+					stack.emplace_back(serialize_frame{ current, 0 });
+					if constexpr (instrumentationEnabled) {
+						deepest = std::max<uint64_t>(deepest, stack.size() - baseSize);
+					}
+				}
+				current = nullptr;
+				while (stack.size() > baseSize) {
+					auto& frame = stack.back();
+					if (frame.value->type == json_type::object_t) {
+						auto& object = frame.value->getObject();
+						if (frame.index < object.size()) {
+							auto& [key, valueNew] = *(object.begin() + static_cast<std::ptrdiff_t>(frame.index++));
+							appendBinaryExt(writer, key, static_cast<uint32_t>(key.size()));
+							if constexpr (instrumentationEnabled && std::is_same_v<writer_type, pointer_writer>) {
+								etf_metrics::global().recordTag(true, static_cast<uint8_t>(etf_type::Binary_Ext), 0, 5 + key.size());
+							}
+							current = &valueNew;
+							break;
+						}
+					} else {
+						auto& array = frame.value->getArray();
+						if (frame.index < array.size()) {
+							current = &array[frame.index++];
+							break;
+						}
+						appendNilExt(writer);
+					}
+					stack.pop_back();
+				}
+			}
+			return deepest;
+		}
+
+		/// @brief Call writeEtfValue(), and record the tag and the bytes written in etf_metrics if instrumentationEnabled is true.
+		/// Only writes into memory are recorded, so that the sizing pass of each serialization is not counted twice.
+		/// @param writer The writer to append to.
 		/// @param dataToParse The etf_serializer object to be serialized.
-		inline void serializeJsonToEtfString(const etf_serializer& dataToParse) {
+		/// @return True if an object or array with elements was opened, false if the value is complete.
+		template<typename writer_type> inline static bool recordEtfValue(writer_type& writer, const etf_serializer& dataToParse) {
+			if constexpr (instrumentationEnabled && std::is_same_v<writer_type, pointer_writer>) {
+				const uint8_t* startPtr = writer.currentPtr;
+				const bool opened		= writeEtfValue(writer, dataToParse);
+				etf_metrics::global().recordTag(true, *startPtr, 0, static_cast<uint64_t>(writer.currentPtr - startPtr));
+				return opened;
+			} else {
+				return writeEtfValue(writer, dataToParse);
+			}
+		}
+
+		/// @brief Serialize a scalar, or the header of an object or array.
+		/// @param writer The writer to append to.
+		/// @param dataToParse The etf_serializer object to be serialized.
+		/// @return True if an object or array with elements was opened, false if the value is complete.
+		template<typename writer_type> inline static bool writeEtfValue(writer_type& writer, const etf_serializer& dataToParse) {
 			switch (dataToParse.type) {
 				case json_type::object_t: {
-					return writeEtfObject(dataToParse.getObject());
+					appendMapHeader(writer, static_cast<uint32_t>(dataToParse.getObject().size()));
+					return !dataToParse.getObject().empty();
 				}
 				case json_type::array_t: {
-					return writeEtfArray(dataToParse.getArray());
+					appendListHeader(writer, static_cast<uint32_t>(dataToParse.getArray().size()));
+					if (dataToParse.getArray().empty()) {
+						appendNilExt(writer);
+						return false;
+					}
+					return true;
 				}
 				case json_type::string_t: {
-					return writeEtfString(dataToParse.getString());
+					writeEtfString(writer, dataToParse.getString());
+					return false;
 				}
 				case json_type::float_t: {
-					return writeEtfFloat(dataToParse.getFloat());
+					writeEtfFloat(writer, dataToParse.getFloat());
+					return false;
 				}
 				case json_type::uint_t: {
-					return writeEtfUint(dataToParse.getUint());
+					writeEtfUint(writer, dataToParse.getUint());
+					return false;
 				}
 				case json_type::int_t: {
-					return writeEtfInt(dataToParse.getInt());
+					writeEtfInt(writer, dataToParse.getInt());
+					return false;
 				}
 				case json_type::bool_t: {
-					return writeEtfBool(dataToParse.getBool());
+					writeEtfBool(writer, dataToParse.getBool());
+					return false;
 				}
 				case json_type::null_t: {
-					return writeEtfNull();
+					writeEtfNull(writer);
+					return false;
 				}
 			}
-		}
-
-		/// @brief Serialize an object_type to an ETF object.
-		/// @param data The object_type to be serialized.
-		inline void writeEtfObject(const object_type& data) {
-			appendMapHeader(static_cast<uint32_t>(data.size()));
-			for (auto& [key, valueNew]: data) {
-				appendBinaryExt(key, static_cast<uint32_t>(key.size()));
-				serializeJsonToEtfString(valueNew);
-			}
-		}
-
-		/// @brief Serialize an array_type to an ETF array.
-		/// @param data The array_type to be serialized.
-		inline void writeEtfArray(const array_type& data) {
-			appendListHeader(static_cast<uint32_t>(data.size()));
-			for (auto& valueNew: data) {
-				serializeJsonToEtfString(valueNew);
-			}
-			appendNilExt();
+			return false;
 		}
 
 		/// @brief Serialize a string_type to an ETF binary string.
+		/// @param writer The writer to append to.
 		/// @param data The string_type to be serialized.
-		inline void writeEtfString(const string_type& data) {
-			appendBinaryExt(data, static_cast<uint32_t>(data.size()));
+		template<typename writer_type> inline static void writeEtfString(writer_type& writer, const string_type& data) {
+			appendBinaryExt(writer, data, static_cast<uint32_t>(data.size()));
 		}
 
 		/// @brief Serialize a uint_type to an ETF unsigned integer.
+		/// @param writer The writer to append to.
 		/// @param data The uint_type to be serialized.
-		inline void writeEtfUint(const uint_type data) {
-			if (data <= std::numeric_limits<uint8_t>::max() && data >= std::numeric_limits<uint8_t>::min()) {
-				appendUint8(static_cast<uint8_t>(data));
-			} else if (data <= std::numeric_limits<uint32_t>::max() && data >= std::numeric_limits<uint32_t>::min()) {
-				appendUint32(static_cast<uint32_t>(data));
+		template<typename writer_type> inline static constexpr void writeEtfUint(writer_type& writer, const uint_type data) {
+			if (data <= std::numeric_limits<uint8_t>::max()) {
+				appendUint8(writer, static_cast<uint8_t>(data));
+			} else if (std::in_range<int32_t>(data)) {
+				appendInt32(writer, static_cast<int32_t>(data));
 			} else {
-				appendUint64(data);
+				appendUint64(writer, data);
 			}
 		}
 
 		/// @brief Serialize an int_type to an ETF signed integer.
+		/// @param writer The writer to append to.
 		/// @param data The int_type to be serialized.
-		inline void writeEtfInt(const int_type data) {
-			if (data <= std::numeric_limits<int8_t>::max() && data >= std::numeric_limits<int8_t>::min()) {
-				appendInt8(static_cast<int8_t>(data));
-			} else if (data <= std::numeric_limits<int32_t>::max() && data >= std::numeric_limits<int32_t>::min()) {
-				appendInt32(static_cast<int32_t>(data));
+		template<typename writer_type> inline static constexpr void writeEtfInt(writer_type& writer, const int_type data) {
+			if (data >= 0 && data <= std::numeric_limits<uint8_t>::max()) {
+				appendUint8(writer, static_cast<uint8_t>(data));
+			} else if (std::in_range<int32_t>(data)) {
+				appendInt32(writer, static_cast<int32_t>(data));
 			} else {
-				appendInt64(data);
+				appendInt64(writer, data);
 			}
 		}
 
 		/// @brief Serialize a float_type to an ETF float.
+		/// @param writer The writer to append to.
 		/// @param data The float_type to be serialized.
-		inline void writeEtfFloat(const float_type data) {
-			appendNewFloatExt(data);
+		template<typename writer_type> inline static constexpr void writeEtfFloat(writer_type& writer, const float_type data) {
+			appendNewFloatExt(writer, data);
 		}
 
 		/// @brief Serialize a bool_type to an ETF boolean.
+		/// @param writer The writer to append to.
 		/// @param data The bool_type to be serialized.
-		inline void writeEtfBool(const bool_type data) {
-			appendBool(data);
+		template<typename writer_type> inline static constexpr void writeEtfBool(writer_type& writer, const bool_type data) {
+			appendBool(writer, data);
 		}
 
 		/// @brief Serialize a null value to ETF null.
-		inline void writeEtfNull() {
-			appendNil();
+		/// @param writer The writer to append to.
+		template<typename writer_type> inline static constexpr void writeEtfNull(writer_type& writer) {
+			appendNil(writer);
 		}
 
-		/// @brief Write a sequence of bytes to the `stringReal` member.
-		/// @tparam value_type The data type of the bytes.
+		/// @brief Write a sequence of bytes to a writer.
+		/// @param writer The writer to append to.
 		/// @param data A pointer to the data to be written.
 		/// @param length The length of the data.
-		template<typename value_type> inline void writeString(const value_type* data, uint64_t length) {
-			auto oldSize = stringReal.size();
-			stringReal.resize(stringReal.size() + length);
-			std::memcpy(stringReal.data() + oldSize, data, length);
+		template<typename writer_type, typename value_type> inline static constexpr void writeString(writer_type& writer, const value_type* data, uint64_t length) {
+			writer.write(data, length);
 		}
 
-		/// @brief Append a binary extension to the `stringReal` member.
+		/// @brief Append a binary extension to a writer.
+		/// @param writer The writer to append to.
 		/// @param bytes The binary data to be appended.
 		/// @param sizeNew The size of the binary data.
-		inline void appendBinaryExt(const std::string& bytes, uint32_t sizeNew) {
+		template<typename writer_type> inline static constexpr void appendBinaryExt(writer_type& writer, std::string_view bytes, uint32_t sizeNew) {
 			uint8_t newBuffer[5]{ static_cast<uint8_t>(etf_type::Binary_Ext) };
 			storeBits(newBuffer + 1, sizeNew);
-			writeString(newBuffer, std::size(newBuffer));
-			writeString(bytes.data(), bytes.size());
+			writeString(writer, newBuffer, std::size(newBuffer));
+			writeString(writer, bytes.data(), bytes.size());
 		}
 
-		/// @brief Append a new float extension to the `stringReal` member.
+		/// @brief Append a new float extension to a writer.
+		/// @param writer The writer to append to.
 		/// @param newFloat The double value to be appended as a new float extension.
-		inline void appendNewFloatExt(const double newFloat) {
+		template<typename writer_type> inline static constexpr void appendNewFloatExt(writer_type& writer, const double newFloat) {
 			uint8_t newBuffer[9]{ static_cast<uint8_t>(etf_type::New_Float_Ext) };
-			uint64_t newValue{};
-			std::memcpy(&newValue, &newFloat, sizeof(newFloat));
-			storeBits(newBuffer + 1, newValue);
-			writeString(newBuffer, std::size(newBuffer));
+			storeBits(newBuffer + 1, std::bit_cast<uint64_t>(newFloat));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
-		/// @brief Append a list header to the `stringReal` member.
+		/// @brief Append a list header to a writer.
+		/// @param writer The writer to append to.
 		/// @param sizeNew The size of the list.
-		inline void appendListHeader(const uint32_t sizeNew) {
+		template<typename writer_type> inline static constexpr void appendListHeader(writer_type& writer, const uint32_t sizeNew) {
 			uint8_t newBuffer[5]{ static_cast<uint8_t>(etf_type::List_Ext) };
 			storeBits(newBuffer + 1, sizeNew);
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
-		/// @brief Append a map header to the `stringReal` member.
+		/// @brief Append a map header to a writer.
+		/// @param writer The writer to append to.
 		/// @param sizeNew The size of the map.
-		inline void appendMapHeader(const uint32_t sizeNew) {
+		template<typename writer_type> inline static constexpr void appendMapHeader(writer_type& writer, const uint32_t sizeNew) {
 			uint8_t newBuffer[5]{ static_cast<uint8_t>(etf_type::Map_Ext) };
 			storeBits(newBuffer + 1, sizeNew);
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
-		/// @brief Append a uint64_t value to the `stringReal` member.
+		/// @brief Append a uint64_t value to a writer.
+		/// @param writer The writer to append to.
 		/// @param valueNew The uint64_t value to be appended.
-		inline void appendUint64(uint64_t valueNew) {
+		template<typename writer_type> inline static constexpr void appendUint64(writer_type& writer, uint64_t valueNew) {
 			uint8_t newBuffer[11]{ static_cast<uint8_t>(etf_type::Small_Big_Ext) };
 			uint8_t encodedBytes{};
 			while (valueNew > 0) {
@@ -1103,86 +2806,78 @@ namespace CppEtfer {
 			}
 			newBuffer[1] = encodedBytes;
 			newBuffer[2] = 0;
-			writeString(newBuffer, 1ull + 2ull + static_cast<uint64_t>(encodedBytes));
+			writeString(writer, newBuffer, 1ull + 2ull + static_cast<uint64_t>(encodedBytes));
 		}
 
-		/// @brief Append an int64_t value to the `stringReal` member.
+		/// @brief Append an int64_t value to a writer.
+		/// @param writer The writer to append to.
 		/// @param valueNew The int64_t value to be appended.
-		inline void appendInt64(int64_t valueNew) {
+		template<typename writer_type> inline static constexpr void appendInt64(writer_type& writer, int64_t valueNew) {
 			uint8_t newBuffer[11]{ static_cast<uint8_t>(etf_type::Small_Big_Ext) };
+			uint64_t magnitude = static_cast<uint64_t>(valueNew);
+			if (valueNew < 0) {
+				newBuffer[2] = 1;
+				magnitude	 = 0 - magnitude;
+			}
 			uint8_t encodedBytes{};
-			while (valueNew > 0) {
-				newBuffer[3 + encodedBytes] = valueNew & 0xFF;
-				valueNew >>= 8;
+			while (magnitude > 0) {
+				newBuffer[3 + encodedBytes] = static_cast<uint8_t>(magnitude & 0xFF);
+				magnitude >>= 8;
 				++encodedBytes;
 			}
 			newBuffer[1] = encodedBytes;
-			if (valueNew >= 0) {
-				newBuffer[2] = 0;
-			} else {
-				newBuffer[2] = 1;
-			}
-			writeString(newBuffer, 1ull + 2ull + static_cast<uint64_t>(encodedBytes));
-		}
-
-		/// @brief Append a uint32_t value to the `stringReal` member.
-		/// @param valueNew The uint32_t value to be appended.
-		inline void appendUint32(const uint32_t valueNew) {
-			uint8_t newBuffer[5]{ static_cast<uint8_t>(etf_type::Integer_Ext) };
-			storeBits(newBuffer + 1, valueNew);
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, 1ull + 2ull + static_cast<uint64_t>(encodedBytes));
 		}
 
-		/// @brief Append an int32_t value to the `stringReal` member.
+		/// @brief Append an int32_t value to a writer.
+		/// @param writer The writer to append to.
 		/// @param valueNew The int32_t value to be appended.
-		inline void appendInt32(const int32_t valueNew) {
+		template<typename writer_type> inline static constexpr void appendInt32(writer_type& writer, const int32_t valueNew) {
 			uint8_t newBuffer[5]{ static_cast<uint8_t>(etf_type::Integer_Ext) };
 			storeBits(newBuffer + 1, valueNew);
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
-		/// @brief Append a uint8_t value to the `stringReal` member.
+		/// @brief Append a uint8_t value to a writer.
+		/// @param writer The writer to append to.
 		/// @param valueNew The uint8_t value to be appended.
-		inline void appendUint8(const uint8_t valueNew) {
-			uint8_t newBuffer[2]{ static_cast<uint8_t>(etf_type::Small_Integer_Ext), static_cast<uint8_t>(valueNew) };
-			writeString(newBuffer, std::size(newBuffer));
-		}
-
-		/// @brief Append an int8_t value to the `stringReal` member.
-		/// @param valueNew The int8_t value to be appended.
-		inline void appendInt8(const int8_t valueNew) {
+		template<typename writer_type> inline static constexpr void appendUint8(writer_type& writer, const uint8_t valueNew) {
 			uint8_t newBuffer[2]{ static_cast<uint8_t>(etf_type::Small_Integer_Ext), static_cast<uint8_t>(valueNew) };
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
-		/// @brief Append a boolean value to the `stringReal` member.
+		/// @brief Append a boolean value to a writer.
+		/// @param writer The writer to append to.
 		/// @param data The boolean value to be appended.
-		inline void appendBool(bool data) {
+		template<typename writer_type> inline static constexpr void appendBool(writer_type& writer, bool data) {
 			if (data) {
 				uint8_t newBuffer[6]{ static_cast<uint8_t>(etf_type::Small_Atom_Ext), static_cast<uint8_t>(4), 't', 'r', 'u', 'e' };
-				writeString(newBuffer, std::size(newBuffer));
+				writeString(writer, newBuffer, std::size(newBuffer));
 			} else {
 				uint8_t newBuffer[7]{ static_cast<uint8_t>(etf_type::Small_Atom_Ext), static_cast<uint8_t>(5), 'f', 'a', 'l', 's', 'e' };
-				writeString(newBuffer, std::size(newBuffer));
+				writeString(writer, newBuffer, std::size(newBuffer));
 			}
 		}
 
-		/// @brief Append the format version to the `stringReal` member.
-		inline void appendVersion() {
+		/// @brief Append the format version to a writer.
+		/// @param writer The writer to append to.
+		template<typename writer_type> inline static constexpr void appendVersion(writer_type& writer) {
 			uint8_t newBuffer[1]{ static_cast<uint8_t>(formatVersion) };
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
-		/// @brief Append a nil extension to the `stringReal` member.
-		inline void appendNilExt() {
+		/// @brief Append a nil extension to a writer.
+		/// @param writer The writer to append to.
+		template<typename writer_type> inline static constexpr void appendNilExt(writer_type& writer) {
 			uint8_t newBuffer[1]{ static_cast<uint8_t>(etf_type::Nil_Ext) };
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
-		/// @brief Append a nil value to the `stringReal` member.
-		inline void appendNil() {
+		/// @brief Append a nil value to a writer.
+		/// @param writer The writer to append to.
+		template<typename writer_type> inline static constexpr void appendNil(writer_type& writer) {
 			uint8_t newBuffer[5]{ static_cast<uint8_t>(etf_type::Small_Atom_Ext), static_cast<uint8_t>(3), 'n', 'i', 'l' };
-			writeString(newBuffer, std::size(newBuffer));
+			writeString(writer, newBuffer, std::size(newBuffer));
 		}
 
 		/// @brief Set the value of the `etf_serializer` based on the specified JSON type and arguments.
@@ -1193,37 +2888,37 @@ namespace CppEtfer {
 			destroyImpl();
 			type = typeNew;
 			if constexpr (typeNew == json_type::object_t) {
-				allocator<object_type> alloc{};
+				allocator<object_type> alloc{ resource };
 				allocator_traits<object_type> allocTraits{};
 				objectValue = allocTraits.allocate(alloc, 1);
 				allocTraits.construct(alloc, objectValue, std::forward<value_types>(args)...);
 			} else if constexpr (typeNew == json_type::array_t) {
-				allocator<array_type> alloc{};
+				allocator<array_type> alloc{ resource };
 				allocator_traits<array_type> allocTraits{};
 				arrayValue = allocTraits.allocate(alloc, 1);
 				allocTraits.construct(alloc, arrayValue, std::forward<value_types>(args)...);
 			} else if constexpr (typeNew == json_type::string_t) {
-				allocator<string_type> alloc{};
+				allocator<string_type> alloc{ resource };
 				allocator_traits<string_type> allocTraits{};
 				stringValue = allocTraits.allocate(alloc, 1);
 				allocTraits.construct(alloc, stringValue, std::forward<value_types>(args)...);
 			} else if constexpr (typeNew == json_type::float_t) {
-				allocator<float_type> alloc{};
+				allocator<float_type> alloc{ resource };
 				allocator_traits<float_type> allocTraits{};
 				floatValue = allocTraits.allocate(alloc, 1);
 				allocTraits.construct(alloc, floatValue, std::forward<value_types>(args)...);
 			} else if constexpr (typeNew == json_type::uint_t) {
-				allocator<uint_type> alloc{};
+				allocator<uint_type> alloc{ resource };
 				allocator_traits<uint_type> allocTraits{};
 				uintValue = allocTraits.allocate(alloc, 1);
 				allocTraits.construct(alloc, uintValue, std::forward<value_types>(args)...);
 			} else if constexpr (typeNew == json_type::int_t) {
-				allocator<int_type> alloc{};
+				allocator<int_type> alloc{ resource };
 				allocator_traits<int_type> allocTraits{};
 				intValue = allocTraits.allocate(alloc, 1);
 				allocTraits.construct(alloc, intValue, std::forward<value_types>(args)...);
 			} else if constexpr (typeNew == json_type::bool_t) {
-				allocator<bool_type> alloc{};
+				allocator<bool_type> alloc{ resource };
 				allocator_traits<bool_type> allocTraits{};
 				boolValue = allocTraits.allocate(alloc, 1);
 				allocTraits.construct(alloc, boolValue, std::forward<value_types>(args)...);
@@ -1234,43 +2929,43 @@ namespace CppEtfer {
 		/// @tparam typeNew The JSON type to destroy.
 		template<json_type typeNew> inline void destroy() {
 			if constexpr (typeNew == json_type::object_t) {
-				allocator<object_type> alloc{};
+				allocator<object_type> alloc{ resource };
 				allocator_traits<object_type> allocTraits{};
 				allocTraits.destroy(alloc, objectValue);
 				alloc.deallocate(static_cast<object_type*>(objectValue), 1);
 				objectValue = nullptr;
 			} else if constexpr (typeNew == json_type::array_t) {
-				allocator<array_type> alloc{};
+				allocator<array_type> alloc{ resource };
 				allocator_traits<array_type> allocTraits{};
 				allocTraits.destroy(alloc, arrayValue);
 				alloc.deallocate(static_cast<array_type*>(arrayValue), 1);
 				arrayValue = nullptr;
 			} else if constexpr (typeNew == json_type::string_t) {
-				allocator<string_type> alloc{};
+				allocator<string_type> alloc{ resource };
 				allocator_traits<string_type> allocTraits{};
 				allocTraits.destroy(alloc, stringValue);
 				alloc.deallocate(static_cast<string_type*>(stringValue), 1);
 				stringValue = nullptr;
 			} else if constexpr (typeNew == json_type::float_t) {
-				allocator<float_type> alloc{};
+				allocator<float_type> alloc{ resource };
 				allocator_traits<float_type> allocTraits{};
 				allocTraits.destroy(alloc, floatValue);
 				alloc.deallocate(static_cast<float_type*>(floatValue), 1);
 				floatValue = nullptr;
 			} else if constexpr (typeNew == json_type::uint_t) {
-				allocator<uint_type> alloc{};
+				allocator<uint_type> alloc{ resource };
 				allocator_traits<uint_type> allocTraits{};
 				allocTraits.destroy(alloc, uintValue);
 				alloc.deallocate(static_cast<uint_type*>(uintValue), 1);
 				uintValue = nullptr;
 			} else if constexpr (typeNew == json_type::int_t) {
-				allocator<int_type> alloc{};
+				allocator<int_type> alloc{ resource };
 				allocator_traits<int_type> allocTraits{};
 				allocTraits.destroy(alloc, intValue);
 				alloc.deallocate(static_cast<int_type*>(intValue), 1);
 				intValue = nullptr;
 			} else if constexpr (typeNew == json_type::bool_t) {
-				allocator<bool_type> alloc{};
+				allocator<bool_type> alloc{ resource };
 				allocator_traits<bool_type> allocTraits{};
 				allocTraits.destroy(alloc, boolValue);
 				alloc.deallocate(static_cast<bool_type*>(boolValue), 1);
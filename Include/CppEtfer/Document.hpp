@@ -0,0 +1,518 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Document.hpp
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+
+#include <vector>
+
+namespace CppEtfer {
+
+	class etf_document;
+
+	/// @brief One value of an indexed ETF document.
+	struct tape_entry {
+		uint32_t offset{};///< The offset of the value's tag within the document.
+		uint32_t length{};///< The number of elements of a list or tuple, pairs of a map, or bytes of a string, atom, binary or big integer.
+		uint32_t next{};///< The index of the entry that follows this value and everything nested within it.
+		etf_type type{};///< The tag of the value.
+	};
+
+	/// @brief A lightweight handle to a value within an etf_document, which decodes only what is accessed.
+	/// Handles remain valid for as long as the document and its buffer do, and until the document parses another buffer.
+	class etf_value {
+	  public:
+		/// @brief Iterator over the elements of a list or tuple, or the values of a map.
+		class iterator {
+		  public:
+			/// @brief Get the element that the iterator points to.
+			/// @return The element.
+			inline etf_value operator*() const {
+				return etf_value{ document, isMap ? nextIndex(index) : index };
+			}
+
+			/// @brief Get the key of the map entry that the iterator points to.
+			/// @return The key.
+			inline etf_value key() const {
+				return etf_value{ document, index };
+			}
+
+			/// @brief Advance to the next element.
+			/// @return A reference to this iterator.
+			inline iterator& operator++() {
+				index = isMap ? nextIndex(nextIndex(index)) : nextIndex(index);
+				--remaining;
+				return *this;
+			}
+
+			/// @brief Compare two iterators for equality.
+			/// @param other The iterator to compare with.
+			/// @return True if both iterators point at the same element.
+			inline bool operator==(const iterator& other) const {
+				return remaining == other.remaining;
+			}
+
+		  protected:
+			friend class etf_value;
+
+			etf_document* document{};///< The document being iterated.
+			uint64_t index{};///< The tape index of the current element, or of its key for maps.
+			uint64_t remaining{};///< The number of elements left, including the current one.
+			bool isMap{};///< Whether the container is a map.
+
+			inline iterator(etf_document* documentNew, uint64_t indexNew, uint64_t remainingNew, bool isMapNew)
+				: document{ documentNew }, index{ indexNew }, remaining{ remainingNew }, isMap{ isMapNew } {
+			}
+
+			inline uint64_t nextIndex(uint64_t indexNew) const;
+		};
+
+		/// @brief Get the ETF tag of the value.
+		/// @return The tag.
+		inline etf_type type() const;
+
+		/// @brief Get the number of elements of a list or tuple, pairs of a map, or bytes of a string, atom or binary.
+		/// @return The size of the value.
+		inline uint64_t size() const;
+
+		/// @brief Check whether the value is the atom nil or null.
+		/// @return True if the value is null, false otherwise.
+		inline bool isNull() const;
+
+		/// @brief Check whether a map holds a key.
+		/// @param key The key to search for.
+		/// @return True if the key exists, false otherwise.
+		inline bool contains(std::string_view key) const;
+
+		/// @brief Access the value of a map with a given key.
+		/// @param key The key to search for.
+		/// @return The value.
+		inline etf_value operator[](std::string_view key) const;
+
+		/// @brief Access an element of a list or tuple.
+		/// @param index The index of the element.
+		/// @return The element.
+		inline etf_value operator[](uint64_t index) const;
+
+		/// @brief Get an iterator to the first element of a list or tuple, or value of a map.
+		/// @return The iterator.
+		inline iterator begin() const;
+
+		/// @brief Get an iterator past the last element of a list, or value of a map.
+		/// @return The iterator.
+		inline iterator end() const;
+
+		/// @brief Get the bytes of a binary, string or atom without copying them.
+		/// @return The bytes.
+		inline std::string_view getString() const;
+
+		/// @brief Decode the value, which may be of any type that etf_parser::parseEtfToData() accepts.
+		/// @param value The value to be decoded into.
+		template<typename value_type> inline void get(value_type& value) const;
+
+		/// @brief Decode the value, which may be of any type that etf_parser::parseEtfToData() accepts.
+		/// @return The decoded value.
+		template<typename value_type> inline value_type get() const {
+			value_type value{};
+			get(value);
+			return value;
+		}
+
+		/// @brief Get the encoded bytes of the value, without the format version.
+		/// @return The bytes.
+		inline std::span<const uint8_t> raw() const;
+
+		/// @brief Convert the value to JSON.
+		/// @return The JSON representation of the value, valid until the next conversion on the same document.
+		inline std::string_view toJson() const;
+
+	  protected:
+		friend class etf_document;
+
+		etf_document* document{};///< The document that holds the value.
+		uint64_t index{};///< The tape index of the value.
+
+		inline etf_value(etf_document* documentNew, uint64_t indexNew) : document{ documentNew }, index{ indexNew } {
+		}
+
+		inline const tape_entry& entry() const;
+
+		inline uint64_t findKey(std::string_view key) const;
+	};
+
+	/// @brief Class for indexing ETF data in a single pass, so that values can be looked up and decoded on demand.
+	/// The index is a tape with one entry per value, holding its tag, offset, length, and the index of the entry that follows it, so that
+	/// whole subtrees are skipped in one step. Nothing is copied or converted until a value is read.
+	class etf_document : protected etf_parser {
+	  public:
+		/// @brief Default constructor.
+		inline etf_document() = default;
+
+		/// @brief Constructor that sets the limit on how deeply lists and maps may be nested.
+		/// @param maxDepthNew The limit on how deeply lists and maps may be nested.
+		inline explicit etf_document(uint64_t maxDepthNew) : etf_parser{ false, maxDepthNew } {
+		}
+
+		/// @brief Index ETF data, reading directly out of the caller's buffer.
+		/// @param dataToParse The ETF data to be indexed, which must outlive the document's values.
+		/// @return The root value.
+		template<string_t string_type> inline etf_value parse(string_type&& dataToParse) {
+			return parse(std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(dataToParse.data()), dataToParse.size() });
+		}
+
+		/// @brief Index ETF data, reading directly out of the caller's buffer.
+		/// @param dataToParse The ETF data to be indexed, which must outlive the document's values.
+		/// @return The root value.
+		inline etf_value parse(std::span<const uint8_t> dataToParse) {
+			if (dataToParse.size() > std::numeric_limits<uint32_t>::max()) {
+				throw std::runtime_error{ "etf_document::parse() Error: Documents are limited to 4 GiB." };
+			}
+			documentBuffer = dataToParse.data();
+			documentSize   = dataToParse.size();
+			loadBuffer(documentBuffer, documentSize);
+			if (readBitsFromBuffer<uint8_t>() != formatVersion) {
+				throw std::runtime_error{ "etf_document::parse() Error: Incorrect format version specified." };
+			}
+			inflateIfCompressed();
+			documentBuffer = dataBuffer;
+			documentSize   = dataSize;
+			buildTape();
+			documentEnd = offSet;
+			return root();
+		}
+
+		/// @brief Index ETF data, taking ownership of the buffer until the next parse.
+		/// @param dataToParse The ETF data to be indexed.
+		/// @return The root value.
+		inline etf_value parse(std::basic_string<uint8_t>&& dataToParse) {
+			ownedBuffer = std::move(dataToParse);
+			return parse(std::span<const uint8_t>{ ownedBuffer.data(), ownedBuffer.size() });
+		}
+
+		/// @brief Get the root value.
+		/// @return The root value.
+		inline etf_value root() {
+			if (tape.empty()) {
+				throw std::runtime_error{ "etf_document::root() Error: No document has been parsed." };
+			}
+			return etf_value{ this, 0 };
+		}
+
+		/// @brief Access the value of the root map with a given key.
+		/// @param key The key to search for.
+		/// @return The value.
+		inline etf_value operator[](std::string_view key) {
+			return root()[key];
+		}
+
+	  protected:
+		friend class etf_value;
+
+		std::vector<tape_entry> tape{};///< One entry per value, in the order that they are encoded.
+		std::vector<uint64_t> tapeStack{};///< The tape indices of the lists and maps being indexed, reused between parses.
+		std::vector<uint64_t> remainingStack{};///< The number of values left in each list and map being indexed.
+		const uint8_t* documentBuffer{};///< Pointer to the indexed ETF data.
+		uint64_t documentSize{};///< Size of the indexed ETF data.
+		uint64_t documentEnd{};///< Offset one past the end of the root value.
+
+		/// @brief Build the tape for the loaded ETF data in one pass, without recursion.
+		inline void buildTape() {
+			tape.clear();
+			tapeStack.clear();
+			remainingStack.clear();
+			do {
+				const uint64_t index = tape.size();
+				auto& newEntry		 = tape.emplace_back();
+				newEntry.offset		 = static_cast<uint32_t>(offSet);
+				newEntry.type		 = static_cast<etf_type>(readBitsFromBuffer<uint8_t>());
+				uint64_t children{};
+				switch (newEntry.type) {
+					case etf_type::New_Float_Ext: {
+						readBytesFromBuffer(8);
+						break;
+					}
+					case etf_type::Small_Integer_Ext: {
+						readBytesFromBuffer(1);
+						break;
+					}
+					case etf_type::Integer_Ext: {
+						readBytesFromBuffer(4);
+						break;
+					}
+					case etf_type::Atom_Ext:
+					case etf_type::Atom_Utf8_Ext:
+					case etf_type::String_Ext: {
+						newEntry.length = readBitsFromBuffer<uint16_t>();
+						readBytesFromBuffer(newEntry.length);
+						break;
+					}
+					case etf_type::Nil_Ext: {
+						break;
+					}
+					case etf_type::List_Ext: {
+						newEntry.length = readBitsFromBuffer<uint32_t>();
+						children		= static_cast<uint64_t>(newEntry.length) + 1;
+						break;
+					}
+					case etf_type::Small_Tuple_Ext: {
+						newEntry.length = readBitsFromBuffer<uint8_t>();
+						children		= newEntry.length;
+						break;
+					}
+					case etf_type::Large_Tuple_Ext: {
+						newEntry.length = readBitsFromBuffer<uint32_t>();
+						children		= newEntry.length;
+						break;
+					}
+					case etf_type::Binary_Ext: {
+						newEntry.length = readBitsFromBuffer<uint32_t>();
+						readBytesFromBuffer(newEntry.length);
+						break;
+					}
+					case etf_type::Bit_Binary_Ext: {
+						newEntry.length = readBitsFromBuffer<uint32_t>();
+						readBytesFromBuffer(static_cast<uint64_t>(newEntry.length) + 1);
+						break;
+					}
+					case etf_type::Small_Big_Ext: {
+						newEntry.length = readBitsFromBuffer<uint8_t>();
+						readBytesFromBuffer(static_cast<uint64_t>(newEntry.length) + 1);
+						break;
+					}
+					case etf_type::Large_Big_Ext: {
+						newEntry.length = readBitsFromBuffer<uint32_t>();
+						checkBigIntegerSize(newEntry.length);
+						readBytesFromBuffer(static_cast<uint64_t>(newEntry.length) + 1);
+						break;
+					}
+					case etf_type::Small_Atom_Ext:
+					case etf_type::Small_Atom_Utf8_Ext: {
+						newEntry.length = readBitsFromBuffer<uint8_t>();
+						readBytesFromBuffer(newEntry.length);
+						break;
+					}
+					case etf_type::Map_Ext: {
+						newEntry.length = readBitsFromBuffer<uint32_t>();
+						children		= static_cast<uint64_t>(newEntry.length) * 2;
+						break;
+					}
+					default: {
+						--offSet;
+						readBytesFromBuffer(valueSize(dataBuffer + offSet, dataSize - offSet));
+						break;
+					}
+				}
+				if (children > 0) {
+					if (tapeStack.size() >= maxDepth) {
+						throw std::runtime_error{ "etf_document::buildTape() Error: Exceeded the maximum nesting depth of " + std::to_string(maxDepth) + "." };
+					}
+					tapeStack.emplace_back(index);
+					remainingStack.emplace_back(children);
+					continue;
+				}
+				newEntry.next = static_cast<uint32_t>(index + 1);
+				while (!remainingStack.empty() && --remainingStack.back() == 0) {
+					tape[tapeStack.back()].next = static_cast<uint32_t>(tape.size());
+					tapeStack.pop_back();
+					remainingStack.pop_back();
+				}
+			} while (!tapeStack.empty());
+		}
+
+		/// @brief Decode a value out of the document.
+		/// @param index The tape index of the value.
+		/// @param value The value to be decoded into.
+		template<typename value_type> inline void decode(uint64_t index, value_type& value) {
+			loadBuffer(documentBuffer + tape[index].offset, documentSize - tape[index].offset);
+			parseData(value);
+		}
+
+		/// @brief Get the offset one past the end of a value.
+		/// @param index The tape index of the value.
+		/// @return The offset.
+		inline uint64_t endOffset(uint64_t index) const {
+			return tape[index].next < tape.size() ? tape[tape[index].next].offset : documentEnd;
+		}
+
+		/// @brief Convert a value to JSON.
+		/// @param index The tape index of the value.
+		/// @return The JSON representation of the value.
+		inline std::string_view toJson(uint64_t index) {
+			const uint64_t begin = tape[index].offset;
+			const uint64_t end	 = endOffset(index);
+			loadBuffer(documentBuffer + begin, end - begin);
+			finalString.resize(maxJsonSize(end - begin));
+			currentPtr = finalString.data();
+			singleValueETFToJson();
+			return std::string_view{ finalString.data(), static_cast<uint64_t>(currentPtr - finalString.data()) };
+		}
+	};
+
+	inline uint64_t etf_value::iterator::nextIndex(uint64_t indexNew) const {
+		return document->tape[indexNew].next;
+	}
+
+	inline const tape_entry& etf_value::entry() const {
+		return document->tape[index];
+	}
+
+	inline etf_type etf_value::type() const {
+		return entry().type;
+	}
+
+	inline uint64_t etf_value::size() const {
+		return entry().length;
+	}
+
+	inline bool etf_value::isNull() const {
+		switch (type()) {
+			case etf_type::Atom_Ext:
+			case etf_type::Small_Atom_Ext:
+			case etf_type::Atom_Utf8_Ext:
+			case etf_type::Small_Atom_Utf8_Ext: {
+				const std::string_view value = getString();
+				return value == "nil" || value == "null";
+			}
+			default: {
+				return false;
+			}
+		}
+	}
+
+	inline std::string_view etf_value::getString() const {
+		const auto& newEntry = entry();
+		uint64_t headerSize{};
+		switch (newEntry.type) {
+			case etf_type::Small_Atom_Ext:
+			case etf_type::Small_Atom_Utf8_Ext: {
+				headerSize = 2;
+				break;
+			}
+			case etf_type::Atom_Ext:
+			case etf_type::Atom_Utf8_Ext:
+			case etf_type::String_Ext: {
+				headerSize = 3;
+				break;
+			}
+			case etf_type::Binary_Ext: {
+				headerSize = 5;
+				break;
+			}
+			case etf_type::Bit_Binary_Ext: {
+				headerSize = 6;
+				break;
+			}
+			default: {
+				throw std::runtime_error{ "etf_value::getString() Error: Sorry, but this value's type is not string." };
+			}
+		}
+		return std::string_view{ reinterpret_cast<const char*>(document->documentBuffer) + newEntry.offset + headerSize, newEntry.length };
+	}
+
+	inline uint64_t etf_value::findKey(std::string_view key) const {
+		const auto& newEntry = entry();
+		if (newEntry.type != etf_type::Map_Ext) {
+			throw std::runtime_error{ "etf_value::operator[]() Error: Sorry, but this value's type is not object." };
+		}
+		uint64_t keyIndex = index + 1;
+		for (uint64_t x = 0; x < newEntry.length; ++x) {
+			const etf_value keyValue{ document, keyIndex };
+			const etf_type keyType = keyValue.type();
+			if (etf_document::isKeyType(keyType) && keyValue.getString() == key) {
+				return document->tape[keyIndex].next;
+			}
+			keyIndex = document->tape[document->tape[keyIndex].next].next;
+		}
+		return 0;
+	}
+
+	inline bool etf_value::contains(std::string_view key) const {
+		return findKey(key) != 0;
+	}
+
+	inline etf_value etf_value::operator[](std::string_view key) const {
+		const uint64_t valueIndex = findKey(key);
+		if (valueIndex == 0) {
+			throw std::out_of_range{ "etf_value::operator[]() Error: Key not found: " + std::string{ key } };
+		}
+		return etf_value{ document, valueIndex };
+	}
+
+	inline etf_value etf_value::operator[](uint64_t indexNew) const {
+		const auto& newEntry = entry();
+		if (newEntry.type != etf_type::List_Ext && newEntry.type != etf_type::Small_Tuple_Ext && newEntry.type != etf_type::Large_Tuple_Ext) {
+			throw std::runtime_error{ "etf_value::operator[]() Error: Sorry, but this value's type is not array." };
+		}
+		if (indexNew >= newEntry.length) {
+			throw std::out_of_range{ "etf_value::operator[]() Error: Index out of range." };
+		}
+		uint64_t elementIndex = index + 1;
+		for (uint64_t x = 0; x < indexNew; ++x) {
+			elementIndex = document->tape[elementIndex].next;
+		}
+		return etf_value{ document, elementIndex };
+	}
+
+	inline etf_value::iterator etf_value::begin() const {
+		const auto& newEntry = entry();
+		switch (newEntry.type) {
+			case etf_type::List_Ext:
+			case etf_type::Small_Tuple_Ext:
+			case etf_type::Large_Tuple_Ext: {
+				return iterator{ document, index + 1, newEntry.length, false };
+			}
+			case etf_type::Map_Ext: {
+				return iterator{ document, index + 1, newEntry.length, true };
+			}
+			case etf_type::Nil_Ext: {
+				return iterator{ document, index, 0, false };
+			}
+			default: {
+				throw std::runtime_error{ "etf_value::begin() Error: Sorry, but this value's type is not array or object." };
+			}
+		}
+	}
+
+	inline etf_value::iterator etf_value::end() const {
+		return iterator{ document, index, 0, false };
+	}
+
+	template<typename value_type> inline void etf_value::get(value_type& value) const {
+		document->decode(index, value);
+	}
+
+	inline std::span<const uint8_t> etf_value::raw() const {
+		const uint64_t begin = entry().offset;
+		return std::span<const uint8_t>{ document->documentBuffer + begin, document->endOffset(index) - begin };
+	}
+
+	inline std::string_view etf_value::toJson() const {
+		return document->toJson(index);
+	}
+
+}
@@ -0,0 +1,295 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Filter.hpp
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+
+#include <initializer_list>
+#include <string_view>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <span>
+
+namespace CppEtfer {
+
+	/// @brief Whether the key paths of an etf_filter name the fields to remove or the fields to keep.
+	enum class etf_filter_mode : uint8_t {
+		deny  = 0,///< Remove the fields at the key paths, and keep everything else.
+		allow = 1,///< Keep the fields at the key paths, along with the maps and lists that lead to them, and remove everything else.
+	};
+
+	/// @brief Class for removing fields from ETF data without decoding it, producing smaller ETF data.
+	/// Fields are named by key paths such as "d._trace" or "d.*.avatar", where "*" matches any key. Lists and tuples are transparent, so
+	/// "d.members.member" names the member field of every element of d.members. The data is walked once: everything that is kept is copied verbatim in runs
+	/// that are as long as possible, removed fields are skipped by their encoded lengths, and the only bytes rewritten are the counts of the
+	/// maps that lost fields.
+	class etf_filter : protected etf_parser {
+	  public:
+		/// @brief Default constructor, which removes nothing until paths are added.
+		inline etf_filter() = default;
+
+		/// @brief Constructor that sets the mode and the key paths.
+		/// @param modeNew Whether the paths name the fields to remove or the fields to keep.
+		/// @param paths The key paths, with keys separated by dots.
+		/// @param maxDepthNew The limit on how deeply lists and maps may be nested.
+		inline explicit etf_filter(etf_filter_mode modeNew, std::initializer_list<std::string_view> paths = {}, uint64_t maxDepthNew = defaultMaxDepth)
+			: etf_parser{ false, maxDepthNew }, mode{ modeNew } {
+			for (auto& path: paths) {
+				addPath(path);
+			}
+		}
+
+		/// @brief Add a key path.
+		/// @param path The key path, with keys separated by dots, and "*" matching any key.
+		inline void addPath(std::string_view path) {
+			if (path.empty()) {
+				throw std::invalid_argument{ "etf_filter::addPath() Error: Key paths may not be empty." };
+			}
+			uint32_t node{};
+			while (true) {
+				const uint64_t dot		   = path.find('.');
+				const std::string_view key = path.substr(0, dot);
+				node					   = findOrAddChild(node, key);
+				if (dot == std::string_view::npos) {
+					break;
+				}
+				path = path.substr(dot + 1);
+			}
+			nodes[node].terminal = true;
+		}
+
+		/// @brief Filter ETF data, reading directly out of the caller's buffer.
+		/// @param dataToFilter The ETF data to be filtered.
+		/// @return The filtered ETF data, valid until the next call or until this filter is destroyed.
+		template<string_t string_type> inline std::span<const uint8_t> filter(string_type&& dataToFilter) {
+			return filter(std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(dataToFilter.data()), dataToFilter.size() });
+		}
+
+		/// @brief Filter ETF data, reading directly out of the caller's buffer.
+		/// A compressed term is inflated first, and the filtered term is left uncompressed.
+		/// @param dataToFilter The ETF data to be filtered.
+		/// @return The filtered ETF data, valid until the next call or until this filter is destroyed.
+		inline std::span<const uint8_t> filter(std::span<const uint8_t> dataToFilter) {
+			loadBuffer(dataToFilter.data(), dataToFilter.size());
+			filtered.resize(dataToFilter.size());
+			outputSize = 0;
+			copyStart  = 0;
+			if (readBitsFromBuffer<uint8_t>() != formatVersion) {
+				throw std::runtime_error{ "etf_filter::filter() Error: Incorrect format version specified." };
+			}
+			if (peekType() == etf_type::Compressed) {
+				inflateIfCompressed();
+				filtered.resize(dataSize + 1);
+				filtered.data()[0] = formatVersion;
+				outputSize		   = 1;
+			}
+			filterImpl();
+			flush(offSet);
+			filtered.resize(outputSize);
+			return std::span<const uint8_t>{ filtered.data(), filtered.size() };
+		}
+
+	  protected:
+		/// @brief One key of the trie of key paths.
+		struct filter_node {
+			std::vector<std::pair<std::string, uint32_t>> children{};///< The keys that may follow this one, and their nodes.
+			uint32_t wildcard{ noNode };///< The node for "*", which matches any key not among children.
+			bool terminal{};///< Whether a key path ends at this node.
+		};
+
+		/// @brief A map, list or tuple whose elements are still being filtered.
+		struct filter_frame {
+			uint64_t remaining{};///< The number of elements left to filter, counting a map's pairs once and a list's tail.
+			uint64_t countOffset{};///< The offset in the output of a map's count.
+			uint32_t count{};///< The number of pairs that a map started with.
+			uint32_t kept{};///< The number of pairs of a map kept so far.
+			uint32_t node{};///< The node of the key path that leads to this map, list or tuple.
+			bool isMap{};///< Whether the frame is a map.
+		};
+
+		static constexpr uint32_t noNode{ std::numeric_limits<uint32_t>::max() };///< The node of a key that no path names.
+
+		std::vector<filter_node> nodes{ filter_node{} };///< The trie of key paths, whose root is the first node.
+		std::vector<filter_frame> frames{};///< The maps, lists and tuples being filtered, reused between calls.
+		uninitialized_buffer<uint8_t> filtered{};///< The filtered ETF data.
+		uint64_t outputSize{};///< The number of bytes written to filtered so far.
+		uint64_t copyStart{};///< The offset of the first input byte that is kept but not yet copied.
+		etf_filter_mode mode{};///< Whether the paths name the fields to remove or the fields to keep.
+
+		/// @brief Find the child of a node with a given key, adding it if it does not exist.
+		/// @param node The parent node.
+		/// @param key The key.
+		/// @return The child node.
+		inline uint32_t findOrAddChild(uint32_t node, std::string_view key) {
+			if (key == "*") {
+				if (nodes[node].wildcard == noNode) {
+					nodes[node].wildcard = static_cast<uint32_t>(nodes.size());
+					nodes.emplace_back();
+				}
+				return nodes[node].wildcard;
+			}
+			for (auto& [childKey, child]: nodes[node].children) {
+				if (childKey == key) {
+					return child;
+				}
+			}
+			const uint32_t child = static_cast<uint32_t>(nodes.size());
+			nodes[node].children.emplace_back(std::string{ key }, child);
+			nodes.emplace_back();
+			return child;
+		}
+
+		/// @brief Find the child of a node that a key leads to.
+		/// @param node The parent node.
+		/// @param key The key.
+		/// @return The child node, or noNode if no path continues with the key.
+		inline uint32_t findChild(uint32_t node, std::string_view key) const {
+			for (auto& [childKey, child]: nodes[node].children) {
+				if (childKey == key) {
+					return child;
+				}
+			}
+			return nodes[node].wildcard;
+		}
+
+		/// @brief Check whether a node has keys below it, so that the maps, lists and tuples that it leads to must be walked.
+		/// @param node The node.
+		/// @return True if the node has children.
+		inline bool hasChildren(uint32_t node) const {
+			return !nodes[node].children.empty() || nodes[node].wildcard != noNode;
+		}
+
+		/// @brief Copy the kept input bytes up to an offset into the output.
+		/// @param endOffset The offset one past the last byte to copy.
+		inline void flush(uint64_t endOffset) {
+			const uint64_t length = endOffset - copyStart;
+			if (length > 0) {
+				std::memcpy(filtered.data() + outputSize, dataBuffer + copyStart, length);
+				outputSize += length;
+			}
+			copyStart = endOffset;
+		}
+
+		/// @brief Remove the input bytes from an offset up to the current offset.
+		/// @param startOffset The offset of the first byte to remove.
+		inline void drop(uint64_t startOffset) {
+			flush(startOffset);
+			copyStart = offSet;
+		}
+
+		/// @brief Filter the next value, opening it if it is a map, list or tuple that the paths lead into, and keeping it whole otherwise.
+		/// @param node The node of the key path that leads to the value.
+		inline void openOrKeep(uint32_t node) {
+			if (!hasChildren(node)) {
+				skipValue();
+				return;
+			}
+			const etf_type type = peekType();
+			if (type != etf_type::Map_Ext && type != etf_type::List_Ext && type != etf_type::Small_Tuple_Ext && type != etf_type::Large_Tuple_Ext) {
+				skipValue();
+				return;
+			}
+			if (frames.size() >= maxDepth) {
+				throw std::runtime_error{ "etf_filter::filter() Error: Exceeded the maximum nesting depth of " + std::to_string(maxDepth) + "." };
+			}
+			++offSet;
+			filter_frame frame{ .node = node, .isMap = type == etf_type::Map_Ext };
+			if (type == etf_type::Small_Tuple_Ext) {
+				frame.remaining = readBitsFromBuffer<uint8_t>();
+			} else {
+				frame.count		  = readBitsFromBuffer<uint32_t>();
+				frame.remaining	  = type == etf_type::List_Ext ? static_cast<uint64_t>(frame.count) + 1 : frame.count;
+				frame.countOffset = outputSize + (offSet - copyStart) - 4;
+			}
+			frames.emplace_back(frame);
+		}
+
+		/// @brief Filter the loaded ETF data, whose format version has already been consumed.
+		inline void filterImpl() {
+			frames.clear();
+			openOrKeep(0);
+			while (!frames.empty()) {
+				auto& frame = frames.back();
+				if (frame.remaining == 0) {
+					if (frame.isMap && frame.kept != frame.count) {
+						flush(offSet);
+						storeBits(filtered.data() + frame.countOffset, frame.kept);
+					}
+					frames.pop_back();
+					continue;
+				}
+				--frame.remaining;
+				const uint32_t parentNode = frame.node;
+				if (!frame.isMap) {
+					openOrKeep(parentNode);
+					continue;
+				}
+				const uint64_t entryStart = offSet;
+				uint32_t node{ noNode };
+				const etf_type keyType = peekType();
+				if (isKeyType(keyType)) {
+					++offSet;
+					node = findChild(parentNode, readStringBytes(keyType));
+				} else {
+					skipValue();
+				}
+				if (mode == etf_filter_mode::deny) {
+					if (node != noNode && nodes[node].terminal) {
+						skipValue();
+						drop(entryStart);
+						continue;
+					}
+					++frame.kept;
+					node == noNode ? skipValue() : openOrKeep(node);
+				} else {
+					if (node == noNode) {
+						skipValue();
+						drop(entryStart);
+						continue;
+					} else if (nodes[node].terminal) {
+						++frame.kept;
+						skipValue();
+						continue;
+					}
+					const etf_type type = peekType();
+					if (type != etf_type::Map_Ext && type != etf_type::List_Ext && type != etf_type::Small_Tuple_Ext && type != etf_type::Large_Tuple_Ext) {
+						skipValue();
+						drop(entryStart);
+						continue;
+					}
+					++frame.kept;
+					openOrKeep(node);
+				}
+			}
+		}
+	};
+
+}
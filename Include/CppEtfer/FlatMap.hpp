@@ -0,0 +1,364 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file FlatMap.hpp
+
+#pragma once
+
+#include <CppEtfer/Concepts.hpp>
+
+#include <memory_resource>
+#include <string_view>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace CppEtfer {
+
+	/// @brief An insertion-ordered map that stores its entries contiguously.
+	/// Small maps are searched linearly, and a hash index over the entries is built once the map grows past hashThreshold entries.
+	/// With interned keys, such as interned_key, lookups compare and hash IDs, and a key that was never interned is rejected without a search.
+	/// @tparam key_type_new The type of the keys, which must be convertible to std::string_view.
+	/// @tparam mapped_type_new The type of the mapped values.
+	template<typename key_type_new, typename mapped_type_new> class flat_map {
+	  public:
+		using key_type		 = key_type_new;
+		using mapped_type	 = mapped_type_new;
+		using value_type	 = std::pair<key_type, mapped_type>;
+		using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+		using iterator		 = typename std::pmr::vector<value_type>::iterator;
+		using const_iterator = typename std::pmr::vector<value_type>::const_iterator;
+
+		/// @brief The number of entries above which lookups go through the hash index.
+		static constexpr uint64_t hashThreshold{ 16 };
+
+		/// @brief Default constructor.
+		inline flat_map() = default;
+
+		/// @brief Constructor for allocating from a specific memory resource.
+		/// @param alloc The allocator to allocate the entries and the index from.
+		inline explicit flat_map(const allocator_type& alloc) : values{ alloc }, buckets{ alloc } {
+		}
+
+		/// @brief Copy constructor for allocating from a specific memory resource.
+		/// @param other The map to be copied.
+		/// @param alloc The allocator to allocate the entries and the index from.
+		inline flat_map(const flat_map& other, const allocator_type& alloc) : values{ other.values, alloc }, buckets{ other.buckets, alloc } {
+		}
+
+		/// @brief Move constructor for allocating from a specific memory resource.
+		/// @param other The map to be moved.
+		/// @param alloc The allocator to allocate the entries and the index from.
+		inline flat_map(flat_map&& other, const allocator_type& alloc) : values{ std::move(other.values), alloc }, buckets{ std::move(other.buckets), alloc } {
+		}
+
+		inline flat_map(const flat_map&)			= default;
+		inline flat_map(flat_map&&)					= default;
+		inline flat_map& operator=(const flat_map&) = default;
+		inline flat_map& operator=(flat_map&&)		= default;
+
+		/// @brief Get the allocator that the entries are allocated from.
+		/// @return The allocator.
+		inline allocator_type get_allocator() const {
+			return values.get_allocator();
+		}
+
+		/// @brief Get an iterator to the first entry.
+		/// @return An iterator to the first entry.
+		inline iterator begin() {
+			return values.begin();
+		}
+
+		/// @brief Get an iterator past the last entry.
+		/// @return An iterator past the last entry.
+		inline iterator end() {
+			return values.end();
+		}
+
+		/// @brief Get an iterator to the first entry.
+		/// @return An iterator to the first entry.
+		inline const_iterator begin() const {
+			return values.begin();
+		}
+
+		/// @brief Get an iterator past the last entry.
+		/// @return An iterator past the last entry.
+		inline const_iterator end() const {
+			return values.end();
+		}
+
+		/// @brief Get the number of entries.
+		/// @return The number of entries.
+		inline uint64_t size() const {
+			return values.size();
+		}
+
+		/// @brief Check whether there are no entries.
+		/// @return True if there are no entries, false otherwise.
+		inline bool empty() const {
+			return values.empty();
+		}
+
+		/// @brief Make room for a number of entries without reallocating.
+		/// @param newCapacity The number of entries to make room for.
+		inline void reserve(uint64_t newCapacity) {
+			values.reserve(newCapacity);
+		}
+
+		/// @brief Remove all of the entries.
+		inline void clear() {
+			values.clear();
+			buckets.clear();
+		}
+
+		/// @brief Find the entry with a given key.
+		/// @param key The key to search for.
+		/// @return An iterator to the entry, or end() if there is none.
+		inline iterator find(std::string_view key) {
+			return values.begin() + static_cast<std::ptrdiff_t>(findIndex(key));
+		}
+
+		/// @brief Find the entry with a given key.
+		/// @param key The key to search for.
+		/// @return An iterator to the entry, or end() if there is none.
+		inline const_iterator find(std::string_view key) const {
+			return values.begin() + static_cast<std::ptrdiff_t>(findIndex(key));
+		}
+
+		/// @brief Check whether an entry with a given key exists.
+		/// @param key The key to search for.
+		/// @return True if the entry exists, false otherwise.
+		inline bool contains(std::string_view key) const {
+			return findIndex(key) != values.size();
+		}
+
+		/// @brief Access the value with a given key.
+		/// @param key The key to search for.
+		/// @return A reference to the value.
+		inline mapped_type& at(std::string_view key) {
+			const uint64_t index = findIndex(key);
+			if (index == values.size()) {
+				throw std::out_of_range{ "flat_map::at() Error: Key not found." };
+			}
+			return values[index].second;
+		}
+
+		/// @brief Access the value with a given key.
+		/// @param key The key to search for.
+		/// @return A reference to the value.
+		inline const mapped_type& at(std::string_view key) const {
+			const uint64_t index = findIndex(key);
+			if (index == values.size()) {
+				throw std::out_of_range{ "flat_map::at() Error: Key not found." };
+			}
+			return values[index].second;
+		}
+
+		/// @brief Access the value with a given key, appending a default-constructed one if there is none.
+		/// @param key The key to search for.
+		/// @return A reference to the value.
+		inline mapped_type& operator[](std::string_view key) {
+			if constexpr (interned_key_t<key_type>) {
+				return operator[](key_type{ key });
+			} else {
+				const uint64_t index = findIndex(key);
+				if (index != values.size()) {
+					return values[index].second;
+				}
+				values.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+				indexBack();
+				return values.back().second;
+			}
+		}
+
+		/// @brief Access the value with a given interned key, appending a default-constructed one if there is none.
+		/// @param key The key to search for.
+		/// @return A reference to the value.
+		inline mapped_type& operator[](const key_type& key)
+			requires interned_key_t<key_type>
+		{
+			const uint64_t index = findIndex(key);
+			if (index != values.size()) {
+				return values[index].second;
+			}
+			values.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+			indexBack();
+			return values.back().second;
+		}
+
+		/// @brief Append an entry, unless one with the same key exists.
+		/// @param value The entry to be appended.
+		/// @return An iterator to the entry with the key, and whether the entry was appended.
+		inline std::pair<iterator, bool> emplace(value_type&& value) {
+			const uint64_t index = findIndex(value.first);
+			if (index != values.size()) {
+				return { values.begin() + static_cast<std::ptrdiff_t>(index), false };
+			}
+			values.emplace_back(std::move(value));
+			indexBack();
+			return { values.end() - 1, true };
+		}
+
+		/// @brief Append an entry, unless one with the same key exists.
+		/// @param key The key of the entry.
+		/// @param args The arguments to construct the value from.
+		/// @return An iterator to the entry with the key, and whether the entry was appended.
+		template<typename... value_types> inline std::pair<iterator, bool> emplace(std::string_view key, value_types&&... args) {
+			const uint64_t index = findIndex(key);
+			if (index != values.size()) {
+				return { values.begin() + static_cast<std::ptrdiff_t>(index), false };
+			}
+			values.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<value_types>(args)...));
+			indexBack();
+			return { values.end() - 1, true };
+		}
+
+		/// @brief Compare two maps for equality, regardless of the order of their entries.
+		/// @param other The map to compare with.
+		/// @return True if both maps hold the same keys with equal values, false otherwise.
+		inline bool operator==(const flat_map& other) const {
+			if (values.size() != other.values.size()) {
+				return false;
+			}
+			for (auto& [key, value]: values) {
+				const uint64_t index = other.findIndex(key);
+				if (index == other.values.size() || !(other.values[index].second == value)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	  protected:
+		std::pmr::vector<value_type> values{};///< The entries, in insertion order.
+		std::pmr::vector<uint32_t> buckets{};///< Open-addressed hash index holding entry indices plus one, empty until the map grows past hashThreshold.
+
+		/// @brief Hash a key for the index.
+		/// @param key The key to hash.
+		/// @return The hash of the key.
+		inline static uint64_t hashKey(std::string_view key) {
+			return std::hash<std::string_view>{}(key);
+		}
+
+		/// @brief Hash an interned key for the index.
+		/// @param key The key to hash.
+		/// @return The hash of the key's ID.
+		inline static uint64_t hashKey(const key_type& key)
+			requires interned_key_t<key_type>
+		{
+			return (uint64_t{ key.getId() } * 0x9E3779B97F4A7C15ull) >> 32;
+		}
+
+		/// @brief Compare two keys.
+		/// @param lhs The first key.
+		/// @param rhs The second key.
+		/// @return True if the keys are equal, false otherwise.
+		inline static bool compareKeys(std::string_view lhs, std::string_view rhs) {
+			return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+		}
+
+		/// @brief Compare two interned keys.
+		/// @param lhs The first key.
+		/// @param rhs The second key.
+		/// @return True if the keys have the same ID, false otherwise.
+		inline static bool compareKeys(const key_type& lhs, const key_type& rhs)
+			requires interned_key_t<key_type>
+		{
+			return lhs.getId() == rhs.getId();
+		}
+
+		/// @brief Find the index of the entry with a given key.
+		/// @param key The key to search for.
+		/// @return The index of the entry, or size() if there is none.
+		inline uint64_t findIndex(std::string_view key) const {
+			if constexpr (interned_key_t<key_type>) {
+				const auto interned = key_type::find(key);
+				return interned ? findIndex(*interned) : values.size();
+			} else {
+				return findKeyIndex(key);
+			}
+		}
+
+		/// @brief Find the index of the entry with a given interned key.
+		/// @param key The key to search for.
+		/// @return The index of the entry, or size() if there is none.
+		inline uint64_t findIndex(const key_type& key) const
+			requires interned_key_t<key_type>
+		{
+			return findKeyIndex(key);
+		}
+
+		/// @brief Search the entries for a key.
+		/// @tparam lookup_type The type of the key, either std::string_view or key_type for interned keys.
+		/// @param key The key to search for.
+		/// @return The index of the entry, or size() if there is none.
+		template<typename lookup_type> inline uint64_t findKeyIndex(const lookup_type& key) const {
+			if (buckets.empty()) {
+				for (uint64_t x = 0; x < values.size(); ++x) {
+					if (compareKeys(values[x].first, key)) {
+						return x;
+					}
+				}
+				return values.size();
+			}
+			const uint64_t mask = buckets.size() - 1;
+			for (uint64_t slot = hashKey(key) & mask; buckets[slot] != 0; slot = (slot + 1) & mask) {
+				if (compareKeys(values[buckets[slot] - 1].first, key)) {
+					return buckets[slot] - 1;
+				}
+			}
+			return values.size();
+		}
+
+		/// @brief Add the last entry to the hash index, building or growing the index as needed.
+		inline void indexBack() {
+			if (values.size() <= hashThreshold) {
+				return;
+			}
+			if (values.size() * 2 > buckets.size()) {
+				buckets.assign(buckets.empty() ? hashThreshold * 4 : buckets.size() * 2, 0);
+				for (uint64_t x = 0; x < values.size(); ++x) {
+					insertIndex(x);
+				}
+			} else {
+				insertIndex(values.size() - 1);
+			}
+		}
+
+		/// @brief Insert an entry into the hash index.
+		/// @param index The index of the entry.
+		inline void insertIndex(uint64_t index) {
+			const uint64_t mask = buckets.size() - 1;
+			uint64_t slot		= hashKey(values[index].first) & mask;
+			while (buckets[slot] != 0) {
+				slot = (slot + 1) & mask;
+			}
+			buckets[slot] = static_cast<uint32_t>(index + 1);
+		}
+	};
+
+}
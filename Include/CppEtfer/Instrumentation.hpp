@@ -0,0 +1,315 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Instrumentation.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <bit>
+
+namespace CppEtfer {
+
+#if defined(CPP_ETFER_INSTRUMENTATION)
+	/// @brief Whether etf_parser and etf_serializer record metrics, set by defining CPP_ETFER_INSTRUMENTATION before including CppEtfer.
+	constexpr bool instrumentationEnabled{ true };
+#else
+	/// @brief Whether etf_parser and etf_serializer record metrics, set by defining CPP_ETFER_INSTRUMENTATION before including CppEtfer.
+	constexpr bool instrumentationEnabled{ false };
+#endif
+
+	/// @brief The kinds of frame that are timed.
+	enum class etf_frame_kind : uint8_t {
+		parse_json = 0,///< ETF converted to JSON by etf_parser.
+		parse_data = 1,///< ETF parsed into a value by etf_parser.
+		serialize  = 2,///< ETF written by etf_serializer, from a tree or from a core<value_type> value.
+	};
+
+	/// @brief The number of etf_frame_kind values.
+	constexpr uint64_t frameKindCount{ 3 };
+
+	/// @brief The number of buckets in a latency histogram. Bucket x counts frames that took fewer than 2^x nanoseconds, and at least 2^(x-1).
+	constexpr uint64_t latencyBucketCount{ 64 };
+
+	/// @brief The counters for one tag.
+	struct etf_tag_metrics {
+		uint64_t count{};///< The number of values with the tag.
+		uint64_t bytesIn{};///< The ETF bytes read for them. Only the headers of lists, tuples and maps are counted, not their elements.
+		uint64_t bytesOut{};///< The bytes written for them, JSON for the parser and ETF for the serializer.
+	};
+
+	/// @brief The counters for one kind of frame.
+	struct etf_frame_metrics {
+		uint64_t count{};///< The number of frames.
+		uint64_t bytesIn{};///< The bytes read by the frames.
+		uint64_t bytesOut{};///< The bytes written by the frames.
+		uint64_t nanoseconds{};///< The time taken by the frames.
+		uint64_t maxDepth{};///< The deepest nesting of lists, tuples, maps, objects or arrays seen in a frame.
+		uint64_t bufferGrowths{};///< The number of times the output buffer that is reused between frames had to grow.
+		uint64_t bufferGrowthBytes{};///< The total number of bytes that the reused output buffer grew by.
+		std::array<uint64_t, latencyBucketCount> latency{};///< The histogram of frame latencies.
+	};
+
+	/// @brief A point-in-time copy of every counter. All counters only ever increase, so rates are the difference between two snapshots.
+	struct etf_metrics_snapshot {
+		std::array<etf_tag_metrics, 256> parserTags{};///< The tags converted to JSON, indexed by etf_type.
+		std::array<etf_tag_metrics, 256> serializerTags{};///< The tags written from etf_serializer trees, indexed by etf_type. Their bytesIn is 0.
+		std::array<etf_frame_metrics, frameKindCount> frames{};///< The frames, indexed by etf_frame_kind.
+
+		/// @brief Get the counters for one kind of frame.
+		/// @param kind The kind of frame.
+		/// @return The counters.
+		inline const etf_frame_metrics& operator[](etf_frame_kind kind) const {
+			return frames[static_cast<uint64_t>(kind)];
+		}
+	};
+
+	/// @brief The measurements of a single frame, as passed to the frame callback.
+	struct etf_frame_record {
+		etf_frame_kind kind{};///< The kind of frame.
+		uint64_t bytesIn{};///< The bytes read.
+		uint64_t bytesOut{};///< The bytes written.
+		uint64_t nanoseconds{};///< The time taken.
+		uint64_t maxDepth{};///< The deepest nesting reached, or 0 where it is not tracked.
+	};
+
+	/// @brief The process-wide metrics recorded by etf_parser and etf_serializer when instrumentationEnabled is true.
+	/// Each thread records into its own shard without contention, so the hot path is a handful of uncontended adds. snapshot() sums the shards,
+	/// and the counts of threads that have exited are kept.
+	class etf_metrics {
+	  public:
+		/// @brief A function called at the end of every frame, from the thread that processed it.
+		using frame_callback = void (*)(const etf_frame_record&);
+
+		/// @brief Get the process-wide metrics.
+		/// @return A reference to the metrics.
+		inline static etf_metrics& global() {
+			static etf_metrics metrics{};
+			return metrics;
+		}
+
+		/// @brief Set the function called at the end of every frame, or clear it with nullptr.
+		/// @param callbackNew The function.
+		inline void setFrameCallback(frame_callback callbackNew) {
+			callback.store(callbackNew, std::memory_order_release);
+		}
+
+		/// @brief Sum the counters of every thread.
+		/// @return The snapshot.
+		inline etf_metrics_snapshot snapshot() {
+			std::lock_guard lock{ mutex };
+			etf_metrics_snapshot result{ retired };
+			for (auto shardNew: shards) {
+				shardNew->addTo(result);
+			}
+			return result;
+		}
+
+		/// @brief Record a converted or written tag.
+		/// @param serializer Whether the tag was written by etf_serializer, rather than converted by etf_parser.
+		/// @param tag The tag.
+		/// @param bytesIn The ETF bytes read.
+		/// @param bytesOut The bytes written.
+		inline void recordTag(bool serializer, uint8_t tag, uint64_t bytesIn, uint64_t bytesOut) {
+			auto& counters = (serializer ? localShard().serializerTags : localShard().parserTags)[tag];
+			counters.count.add(1);
+			counters.bytesIn.add(bytesIn);
+			counters.bytesOut.add(bytesOut);
+		}
+
+		/// @brief Record the growth of an output buffer that is reused between frames.
+		/// @param kind The kind of frame that the buffer belongs to.
+		/// @param bytes The number of bytes that the buffer grew by.
+		inline void recordGrowth(etf_frame_kind kind, uint64_t bytes) {
+			auto& counters = localShard().frames[static_cast<uint64_t>(kind)];
+			counters.bufferGrowths.add(1);
+			counters.bufferGrowthBytes.add(bytes);
+		}
+
+		/// @brief Record a completed frame, and pass it to the frame callback.
+		/// @param record The measurements of the frame.
+		inline void recordFrame(const etf_frame_record& record) {
+			auto& counters = localShard().frames[static_cast<uint64_t>(record.kind)];
+			counters.count.add(1);
+			counters.bytesIn.add(record.bytesIn);
+			counters.bytesOut.add(record.bytesOut);
+			counters.nanoseconds.add(record.nanoseconds);
+			counters.maxDepth.max(record.maxDepth);
+			counters.latency[std::min<uint64_t>(std::bit_width(record.nanoseconds), latencyBucketCount - 1)].add(1);
+			if (auto callbackNew = callback.load(std::memory_order_acquire)) {
+				callbackNew(record);
+			}
+		}
+
+	  protected:
+		/// @brief A counter that only its own thread writes, and that other threads may read at any time.
+		struct counter {
+			std::atomic<uint64_t> value{};///< The count.
+
+			inline void add(uint64_t amount) {
+				value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+			}
+
+			inline void max(uint64_t amount) {
+				if (amount > value.load(std::memory_order_relaxed)) {
+					value.store(amount, std::memory_order_relaxed);
+				}
+			}
+
+			inline uint64_t load() const {
+				return value.load(std::memory_order_relaxed);
+			}
+		};
+
+		struct tag_counters {
+			counter count{};
+			counter bytesIn{};
+			counter bytesOut{};
+		};
+
+		struct frame_counters {
+			counter count{};
+			counter bytesIn{};
+			counter bytesOut{};
+			counter nanoseconds{};
+			counter maxDepth{};
+			counter bufferGrowths{};
+			counter bufferGrowthBytes{};
+			std::array<counter, latencyBucketCount> latency{};
+		};
+
+		/// @brief The counters of one thread.
+		struct shard {
+			std::array<tag_counters, 256> parserTags{};
+			std::array<tag_counters, 256> serializerTags{};
+			std::array<frame_counters, frameKindCount> frames{};
+
+			/// @brief Add these counters to a snapshot.
+			/// @param result The snapshot to add to.
+			inline void addTo(etf_metrics_snapshot& result) const {
+				for (uint64_t x = 0; x < 256; ++x) {
+					addTag(result.parserTags[x], parserTags[x]);
+					addTag(result.serializerTags[x], serializerTags[x]);
+				}
+				for (uint64_t x = 0; x < frameKindCount; ++x) {
+					auto& resultFrame = result.frames[x];
+					auto& frame		  = frames[x];
+					resultFrame.count += frame.count.load();
+					resultFrame.bytesIn += frame.bytesIn.load();
+					resultFrame.bytesOut += frame.bytesOut.load();
+					resultFrame.nanoseconds += frame.nanoseconds.load();
+					resultFrame.maxDepth = std::max(resultFrame.maxDepth, frame.maxDepth.load());
+					resultFrame.bufferGrowths += frame.bufferGrowths.load();
+					resultFrame.bufferGrowthBytes += frame.bufferGrowthBytes.load();
+					for (uint64_t y = 0; y < latencyBucketCount; ++y) {
+						resultFrame.latency[y] += frame.latency[y].load();
+					}
+				}
+			}
+
+			inline static void addTag(etf_tag_metrics& result, const tag_counters& tag) {
+				result.count += tag.count.load();
+				result.bytesIn += tag.bytesIn.load();
+				result.bytesOut += tag.bytesOut.load();
+			}
+		};
+
+		/// @brief Registers the shard of a thread on its first use, and folds it into retired when the thread exits.
+		struct shard_registration {
+			etf_metrics* owner{};
+			shard* value{};
+
+			inline explicit shard_registration(etf_metrics* ownerNew) : owner{ ownerNew }, value{ new shard{} } {
+				std::lock_guard lock{ owner->mutex };
+				owner->shards.emplace_back(value);
+			}
+
+			inline ~shard_registration() {
+				std::lock_guard lock{ owner->mutex };
+				value->addTo(owner->retired);
+				owner->shards.erase(std::find(owner->shards.begin(), owner->shards.end(), value));
+				delete value;
+			}
+		};
+
+		std::atomic<frame_callback> callback{};///< The function called at the end of every frame.
+		std::vector<shard*> shards{};///< The shards of the running threads.
+		etf_metrics_snapshot retired{};///< The counts of threads that have exited.
+		std::mutex mutex{};///< Guards shards and retired.
+
+		inline etf_metrics() = default;
+
+		/// @brief Get the shard of the calling thread.
+		/// @return A reference to the shard.
+		inline shard& localShard() {
+			thread_local shard_registration registration{ this };
+			return *registration.value;
+		}
+	};
+
+	/// @brief Times a frame and records it in etf_metrics::global(). Without CPP_ETFER_INSTRUMENTATION it does nothing, and compiles away.
+	class frame_timer {
+	  public:
+		inline frame_timer() {
+			if constexpr (instrumentationEnabled) {
+				start = std::chrono::steady_clock::now();
+			}
+		}
+
+		/// @brief Record the frame.
+		/// @param kind The kind of frame.
+		/// @param bytesIn The bytes read.
+		/// @param bytesOut The bytes written.
+		/// @param maxDepth The deepest nesting reached, or 0 where it is not tracked.
+		inline void finish(etf_frame_kind kind, uint64_t bytesIn, uint64_t bytesOut, uint64_t maxDepth = 0) const {
+			if constexpr (instrumentationEnabled) {
+				const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+				etf_metrics::global().recordFrame(etf_frame_record{ kind, bytesIn, bytesOut, static_cast<uint64_t>(nanoseconds), maxDepth });
+			}
+		}
+
+	  protected:
+		std::chrono::steady_clock::time_point start{};///< When the frame started.
+	};
+
+	/// @brief Record the growth of an output buffer that is reused between frames, if instrumentationEnabled is true.
+	/// @param kind The kind of frame that the buffer belongs to.
+	/// @param oldCapacity The capacity of the buffer before it was resized.
+	/// @param newCapacity The capacity of the buffer after it was resized.
+	inline void recordBufferGrowth(etf_frame_kind kind, uint64_t oldCapacity, uint64_t newCapacity) {
+		if constexpr (instrumentationEnabled) {
+			if (newCapacity > oldCapacity) {
+				etf_metrics::global().recordGrowth(kind, newCapacity - oldCapacity);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,303 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file KeyTable.hpp
+
+#pragma once
+
+#include <memory_resource>
+#include <shared_mutex>
+#include <string_view>
+#include <stdexcept>
+#include <algorithm>
+#include <optional>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <bit>
+
+namespace CppEtfer {
+
+	/// @brief A dictionary that assigns each distinct key a stable 32-bit ID, storing the bytes of every key once.
+	/// Keys are never removed, so IDs and the views returned for them stay valid for the lifetime of the table. Each thread caches the IDs
+	/// of the keys that it looked up recently, so repeated keys are found without locking. Other keys take a shared lock, only keys that
+	/// are new lock exclusively, and views are read without locking.
+	class key_table {
+	  public:
+		/// @brief The number of keys in the first block of views, with each following block twice the size of the one before.
+		static constexpr uint64_t firstBlockSize{ 64 };
+		/// @brief The number of blocks of views, enough to hold every 32-bit ID.
+		static constexpr uint64_t blockCount{ 27 };
+		/// @brief The number of entries in each thread's cache of recently looked up keys.
+		static constexpr uint64_t cacheSize{ 256 };
+
+		/// @brief Constructor, which interns the empty key as ID 0.
+		/// @param upstream The memory resource that the keys and views are allocated from.
+		inline explicit key_table(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) : storage{ upstream }, serial{ nextSerial() } {
+			insert(std::string_view{});
+		}
+
+		inline key_table(const key_table&)			  = delete;
+		inline key_table& operator=(const key_table&) = delete;
+
+		/// @brief Get the table shared by the whole process, which interned_key refers to.
+		/// @return A reference to the table.
+		inline static key_table& global() {
+			static key_table table{};
+			return table;
+		}
+
+		/// @brief Get the ID of a key, adding the key if it is new.
+		/// @param key The key to intern.
+		/// @return The ID of the key.
+		inline uint32_t intern(std::string_view key) {
+			const uint64_t hash = std::hash<std::string_view>{}(key);
+			cache_entry& entry	= cachedEntry(hash);
+			if (entry.serial == serial && view(entry.id) == key) {
+				return entry.id;
+			}
+			uint32_t index{};
+			{
+				std::shared_lock lock{ mutex };
+				index = findIndex(key, hash);
+			}
+			if (index == 0) {
+				std::unique_lock lock{ mutex };
+				index = findIndex(key, hash);
+				if (index == 0) {
+					index = insert(key) + 1;
+				}
+			}
+			entry = cache_entry{ serial, index - 1 };
+			return index - 1;
+		}
+
+		/// @brief Get the ID of a key without adding it.
+		/// @param key The key to search for.
+		/// @return The ID of the key, or std::nullopt if it has not been interned.
+		inline std::optional<uint32_t> find(std::string_view key) const {
+			const uint64_t hash = std::hash<std::string_view>{}(key);
+			cache_entry& entry	= cachedEntry(hash);
+			if (entry.serial == serial && view(entry.id) == key) {
+				return entry.id;
+			}
+			std::shared_lock lock{ mutex };
+			if (const uint32_t index = findIndex(key, hash); index != 0) {
+				entry = cache_entry{ serial, index - 1 };
+				return index - 1;
+			}
+			return std::nullopt;
+		}
+
+		/// @brief Get the bytes of an interned key.
+		/// @param id The ID of the key, which must have been returned by this table.
+		/// @return A view of the key, valid for the lifetime of the table.
+		inline std::string_view view(uint32_t id) const {
+			const uint64_t block = blockIndex(id);
+			return blocks[block].load(std::memory_order_acquire)[id - blockStart(block)];
+		}
+
+		/// @brief Get the number of interned keys, including the empty key.
+		/// @return The number of keys.
+		inline uint64_t size() const {
+			return count.load(std::memory_order_acquire);
+		}
+
+	  protected:
+		/// @brief An entry of a thread's cache of recently looked up keys.
+		struct cache_entry {
+			uint64_t serial{};///< The serial number of the table that the ID belongs to, or 0 if the entry is empty.
+			uint32_t id{};///< The ID of the key.
+		};
+
+		mutable std::shared_mutex mutex{};///< Guards buckets, and the insertion of keys.
+		std::pmr::monotonic_buffer_resource storage;///< Holds the bytes of the keys and the blocks of views.
+		std::atomic<std::string_view*> blocks[blockCount]{};///< The views of the keys, indexed by ID.
+		std::vector<uint32_t> buckets{};///< Open-addressed hash index holding IDs plus one.
+		std::atomic<uint32_t> count{};///< The number of interned keys.
+		uint64_t serial{};///< The number that identifies this table in the caches, unique for the lifetime of the process.
+
+		/// @brief Get a new serial number, so that a table constructed where another was destroyed never matches its cache entries.
+		/// @return The serial number, which is never 0.
+		inline static uint64_t nextSerial() {
+			static std::atomic<uint64_t> lastSerial{};
+			return lastSerial.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		/// @brief Get the entry of the calling thread's cache that a key hashes to.
+		/// @param hash The hash of the key.
+		/// @return A reference to the entry.
+		inline static cache_entry& cachedEntry(uint64_t hash) {
+			thread_local cache_entry entries[cacheSize]{};
+			return entries[hash & (cacheSize - 1)];
+		}
+
+		/// @brief Get the block that holds the view of an ID.
+		/// @param id The ID.
+		/// @return The index of the block.
+		inline static uint64_t blockIndex(uint64_t id) {
+			return static_cast<uint64_t>(std::bit_width(id / firstBlockSize + 1)) - 1;
+		}
+
+		/// @brief Get the first ID held by a block.
+		/// @param block The index of the block.
+		/// @return The first ID.
+		inline static uint64_t blockStart(uint64_t block) {
+			return firstBlockSize * ((uint64_t{ 1 } << block) - 1);
+		}
+
+		/// @brief Find the bucket entry of a key, with the mutex held.
+		/// @param key The key to search for.
+		/// @param hash The hash of the key.
+		/// @return The ID of the key plus one, or 0 if it has not been interned.
+		inline uint32_t findIndex(std::string_view key, uint64_t hash) const {
+			if (buckets.empty()) {
+				return 0;
+			}
+			const uint64_t mask = buckets.size() - 1;
+			for (uint64_t slot = hash & mask; buckets[slot] != 0; slot = (slot + 1) & mask) {
+				if (view(buckets[slot] - 1) == key) {
+					return buckets[slot];
+				}
+			}
+			return 0;
+		}
+
+		/// @brief Add a new key, with the mutex held exclusively.
+		/// @param key The key to add.
+		/// @return The ID of the key.
+		inline uint32_t insert(std::string_view key) {
+			const uint32_t id = count.load(std::memory_order_relaxed);
+			if (id == std::numeric_limits<uint32_t>::max()) {
+				throw std::runtime_error{ "key_table::intern() Error: Exceeded the maximum number of keys." };
+			}
+			const uint64_t block = blockIndex(id);
+			std::string_view* views{ blocks[block].load(std::memory_order_relaxed) };
+			if (views == nullptr) {
+				views = static_cast<std::string_view*>(storage.allocate(sizeof(std::string_view) * (firstBlockSize << block), alignof(std::string_view)));
+				blocks[block].store(views, std::memory_order_release);
+			}
+			char* bytes = static_cast<char*>(storage.allocate(std::max<uint64_t>(key.size(), 1), 1));
+			if (!key.empty()) {
+				std::memcpy(bytes, key.data(), key.size());
+			}
+			views[id - blockStart(block)] = std::string_view{ bytes, key.size() };
+			count.store(id + 1, std::memory_order_release);
+			if ((uint64_t{ id } + 1) * 2 > buckets.size()) {
+				buckets.assign(buckets.empty() ? firstBlockSize * 2 : buckets.size() * 2, 0);
+				for (uint32_t x = 0; x <= id; ++x) {
+					insertIndex(x);
+				}
+			} else {
+				insertIndex(id);
+			}
+			return id;
+		}
+
+		/// @brief Insert a key into the hash index.
+		/// @param id The ID of the key.
+		inline void insertIndex(uint32_t id) {
+			const uint64_t mask = buckets.size() - 1;
+			uint64_t slot		= std::hash<std::string_view>{}(view(id)) & mask;
+			while (buckets[slot] != 0) {
+				slot = (slot + 1) & mask;
+			}
+			buckets[slot] = id + 1;
+		}
+	};
+
+	/// @brief A 4-byte handle to a key in key_table::global(), which compares and hashes by ID instead of by its bytes.
+	/// Used as the key of etf_serializer's objects, and usable as the key type of any map that is parsed into or serialized from.
+	class interned_key {
+	  public:
+		/// @brief Default constructor, for the empty key.
+		inline interned_key() = default;
+
+		/// @brief Constructor that interns a key.
+		/// @param key The key to intern.
+		inline interned_key(std::string_view key) : id{ key_table::global().intern(key) } {
+		}
+
+		/// @brief Get the handle of a key without interning it.
+		/// @param key The key to search for.
+		/// @return The handle, or std::nullopt if no handle to the key has been made, in which case no map holds it either.
+		inline static std::optional<interned_key> find(std::string_view key) {
+			if (const auto id = key_table::global().find(key)) {
+				interned_key newKey{};
+				newKey.id = *id;
+				return newKey;
+			}
+			return std::nullopt;
+		}
+
+		/// @brief Get the ID of the key.
+		/// @return The ID.
+		inline uint32_t getId() const {
+			return id;
+		}
+
+		/// @brief Get the bytes of the key.
+		/// @return A view of the key, valid for the lifetime of the process.
+		inline std::string_view view() const {
+			return key_table::global().view(id);
+		}
+
+		/// @brief Get the bytes of the key.
+		/// @return A view of the key, valid for the lifetime of the process.
+		inline operator std::string_view() const {
+			return view();
+		}
+
+		/// @brief Get a pointer to the bytes of the key.
+		/// @return A pointer to the first byte.
+		inline const char* data() const {
+			return view().data();
+		}
+
+		/// @brief Get the length of the key.
+		/// @return The number of bytes.
+		inline uint64_t size() const {
+			return view().size();
+		}
+
+		/// @brief Compare two keys by ID.
+		/// @param other The key to compare with.
+		/// @return True if both handles refer to the same key.
+		inline bool operator==(const interned_key& other) const = default;
+
+	  protected:
+		uint32_t id{};///< The ID of the key in key_table::global().
+	};
+
+}
+
+template<> struct std::hash<CppEtfer::interned_key> {
+	inline std::size_t operator()(const CppEtfer::interned_key& key) const {
+		return static_cast<std::size_t>(key.getId() * 0x9E3779B97F4A7C15ull);
+	}
+};
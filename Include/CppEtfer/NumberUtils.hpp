@@ -0,0 +1,187 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file NumberUtils.hpp
+
+#pragma once
+
+#include <CppEtfer/Concepts.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <bit>
+
+namespace CppEtfer {
+
+	/// @brief The largest number of characters written by any of the toChars overloads.
+	constexpr uint64_t maxNumberCharSize{ 32 };
+
+	/// @brief The two-character decimal representations of 0 through 99.
+	constexpr auto digitPairs{ [] {
+		std::array<char, 200> returnValues{};
+		for (uint64_t x = 0; x < 100; ++x) {
+			returnValues[x * 2]		= static_cast<char>('0' + x / 10);
+			returnValues[x * 2 + 1] = static_cast<char>('0' + x % 10);
+		}
+		return returnValues;
+	}() };
+
+	/// @brief A precomputed decimal representation of a byte.
+	struct small_integer_chars {
+		char chars[4]{};///< The digits, padded to four characters so that they can be copied with a single store.
+		uint8_t length{};///< The number of digits.
+	};
+
+	/// @brief The decimal representations of every Small_Integer_Ext value.
+	constexpr auto smallIntegerTable{ [] {
+		std::array<small_integer_chars, 256> returnValues{};
+		for (uint64_t x = 0; x < 256; ++x) {
+			auto& newValue = returnValues[x];
+			if (x >= 100) {
+				newValue.chars[newValue.length++] = static_cast<char>('0' + x / 100);
+			}
+			if (x >= 10) {
+				newValue.chars[newValue.length++] = static_cast<char>('0' + (x / 10) % 10);
+			}
+			newValue.chars[newValue.length++] = static_cast<char>('0' + x % 10);
+		}
+		return returnValues;
+	}() };
+
+	/// @brief Powers of ten that fit in a uint64_t.
+	constexpr auto powersOfTen{ [] {
+		std::array<uint64_t, 20> returnValues{};
+		uint64_t newValue{ 1 };
+		for (uint64_t x = 0; x < returnValues.size(); ++x) {
+			returnValues[x] = newValue;
+			newValue *= 10;
+		}
+		return returnValues;
+	}() };
+
+	/// @brief Count the decimal digits of an unsigned integer.
+	/// @param value The value to count the digits of.
+	/// @return The number of digits, at least one.
+	inline uint64_t digitCount(uint64_t value) {
+		const uint64_t approximation = (static_cast<uint64_t>(std::bit_width(value | 1)) * 1233) >> 12;
+		return approximation + ((value | 1) >= powersOfTen[approximation] ? 1 : 0);
+	}
+
+	/// @brief Write the decimal representation of an unsigned integer, two digits at a time.
+	/// @param out Pointer to the output, which must have room for maxNumberCharSize characters.
+	/// @param value The value to write.
+	/// @return Pointer to one past the last written character.
+	template<unsigned_t value_type> inline char* toChars(char* out, value_type value) {
+		const uint64_t length = digitCount(value);
+		char* newPtr		  = out + length;
+		while (value >= 100) {
+			const uint64_t index = static_cast<uint64_t>(value % 100) * 2;
+			value /= 100;
+			newPtr -= 2;
+			std::memcpy(newPtr, digitPairs.data() + index, 2);
+		}
+		if (value >= 10) {
+			std::memcpy(out, digitPairs.data() + static_cast<uint64_t>(value) * 2, 2);
+		} else {
+			*out = static_cast<char>('0' + value);
+		}
+		return out + length;
+	}
+
+	/// @brief Write the decimal representation of a signed integer, two digits at a time.
+	/// @param out Pointer to the output, which must have room for maxNumberCharSize characters.
+	/// @param value The value to write.
+	/// @return Pointer to one past the last written character.
+	template<signed_t value_type> inline char* toChars(char* out, value_type value) {
+		using unsigned_type = std::make_unsigned_t<value_type>;
+		if (value < 0) {
+			*out++ = '-';
+			return toChars(out, static_cast<unsigned_type>(0 - static_cast<unsigned_type>(value)));
+		}
+		return toChars(out, static_cast<unsigned_type>(value));
+	}
+
+	/// @brief Write the decimal representation of an unsigned integer of any length, as stored by Small_Big_Ext and Large_Big_Ext.
+	/// The value is divided down nine digits at a time, so the work grows with the square of its length.
+	/// @param out Pointer to the output, which must have room for three characters per byte of the value.
+	/// @param bytes Pointer to the bytes of the value, least significant first.
+	/// @param length The number of bytes.
+	/// @param scratch Storage for the intermediate values, reused between calls.
+	/// @return Pointer to one past the last written character.
+	inline char* bigToChars(char* out, const uint8_t* bytes, uint64_t length, std::vector<uint32_t>& scratch) {
+		uint64_t limbCount = (length + 3) / 4;
+		scratch.assign(limbCount, 0);
+		for (uint64_t x = 0; x < length; ++x) {
+			scratch[x / 4] |= static_cast<uint32_t>(bytes[x]) << (8 * (x % 4));
+		}
+		while (limbCount > 0 && scratch[limbCount - 1] == 0) {
+			--limbCount;
+		}
+		if (limbCount == 0) {
+			*out = '0';
+			return out + 1;
+		}
+		const uint64_t chunkStart = scratch.size();
+		while (limbCount > 0) {
+			uint64_t remainder{};
+			for (uint64_t x = limbCount; x-- > 0;) {
+				const uint64_t current = (remainder << 32) | scratch[x];
+				scratch[x]			   = static_cast<uint32_t>(current / 1000000000);
+				remainder			   = current % 1000000000;
+			}
+			scratch.emplace_back(static_cast<uint32_t>(remainder));
+			while (limbCount > 0 && scratch[limbCount - 1] == 0) {
+				--limbCount;
+			}
+		}
+		out = toChars(out, scratch.back());
+		for (uint64_t x = scratch.size() - 1; x-- > chunkStart;) {
+			uint32_t chunk = scratch[x];
+			for (uint64_t y = 9; y-- > 0;) {
+				out[y] = static_cast<char>('0' + chunk % 10);
+				chunk /= 10;
+			}
+			out += 9;
+		}
+		return out;
+	}
+
+	/// @brief Write the shortest decimal representation of a double that round-trips back to the same value.
+	/// @param out Pointer to the output, which must have room for maxNumberCharSize characters.
+	/// @param value The value to write, non-finite values are written as null.
+	/// @return Pointer to one past the last written character.
+	inline char* toChars(char* out, double value) {
+		if (!std::isfinite(value)) {
+			std::memcpy(out, "null", 4);
+			return out + 4;
+		}
+		return std::to_chars(out, out + maxNumberCharSize, value).ptr;
+	}
+
+}
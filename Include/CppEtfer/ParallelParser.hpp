@@ -0,0 +1,290 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file ParallelParser.hpp
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <iterator>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <span>
+
+namespace CppEtfer {
+
+	/// @brief Class for parsing batches of ETF frames in parallel, across a pool of worker threads.
+	/// Each batch is split evenly between the workers, including the calling thread. A worker takes small chunks from the front of its own
+	/// range, and once that is empty, steals half of what is left from the back of another worker's range, so that a few large frames do not
+	/// hold up the batch. Every worker keeps its own etf_parser and output buffer between batches, and results are returned in input order.
+	class etf_parallel_parser {
+	  public:
+		/// @brief Constructor.
+		/// @param threadCountNew The number of threads to parse with, including the calling thread.
+		/// @param checkUtf8New Whether to validate that strings are well-formed UTF-8.
+		/// @param maxDepthNew The limit on how deeply lists and maps may be nested.
+		inline explicit etf_parallel_parser(uint64_t threadCountNew = std::max(std::thread::hardware_concurrency(), 1u), bool checkUtf8New = false,
+			uint64_t maxDepthNew = defaultMaxDepth) {
+			threadCountNew = std::max(threadCountNew, uint64_t{ 1 });
+			for (uint64_t x = 0; x < threadCountNew; ++x) {
+				workers.emplace_back(std::make_unique<worker>(checkUtf8New, maxDepthNew));
+			}
+			for (uint64_t x = 1; x < threadCountNew; ++x) {
+				threads.emplace_back(&etf_parallel_parser::threadFunction, this, x);
+			}
+		}
+
+		inline etf_parallel_parser(const etf_parallel_parser&)			  = delete;
+		inline etf_parallel_parser& operator=(const etf_parallel_parser&) = delete;
+
+		/// @brief Get the number of threads that batches are parsed with, including the calling thread.
+		/// @return The number of threads.
+		inline uint64_t threadCount() const {
+			return workers.size();
+		}
+
+		/// @brief Parse a batch of ETF frames to JSON.
+		/// @tparam frame_type The type of the frames, any contiguous container of bytes or characters.
+		/// @param frames The frames to be parsed, which must stay alive for the duration of the call.
+		/// @return The JSON of each frame in input order, valid until the next batch.
+		template<typename frame_type> inline std::span<const std::string_view> parseEtfToJson(std::span<const frame_type> frames) {
+			locations.resize(frames.size());
+			for (auto& value: workers) {
+				value->output.clear();
+			}
+			run(frames.size(), [&](uint64_t workerIndex, uint64_t index) {
+				auto& newWorker				   = *workers[workerIndex];
+				const std::string_view newJson = newWorker.parser.parseEtfToJson(toBytes(frames[index]));
+				locations[index]			   = output_location{ workerIndex, newWorker.output.size(), newJson.size() };
+				newWorker.output.append(newJson.data(), newJson.size());
+			});
+			results.resize(frames.size());
+			for (uint64_t x = 0; x < frames.size(); ++x) {
+				results[x] = std::string_view{ workers[locations[x].worker]->output.data() + locations[x].offset, locations[x].length };
+			}
+			return std::span<const std::string_view>{ results.data(), results.size() };
+		}
+
+		/// @brief Parse a batch of ETF frames to JSON.
+		/// @tparam frame_type The type of the frames, any contiguous container of bytes or characters.
+		/// @param frames The frames to be parsed, which must stay alive for the duration of the call.
+		/// @return The JSON of each frame in input order, valid until the next batch.
+		template<typename frame_type> inline std::span<const std::string_view> parseEtfToJson(const std::vector<frame_type>& frames) {
+			return parseEtfToJson(std::span<const frame_type>{ frames.data(), frames.size() });
+		}
+
+		/// @brief Parse a batch of ETF frames directly into data structures.
+		/// @tparam value_type The type of the data structures, which may be any type that etf_parser::parseEtfToData() accepts.
+		/// @tparam frame_type The type of the frames, any contiguous container of bytes or characters.
+		/// @param values The data structures to be parsed into, one per frame.
+		/// @param frames The frames to be parsed, which must stay alive for the duration of the call.
+		template<typename value_type, typename frame_type> inline void parseEtfToData(std::span<value_type> values, std::span<const frame_type> frames) {
+			if (values.size() != frames.size()) {
+				throw std::runtime_error{ "etf_parallel_parser::parseEtfToData() Error: Expected one value per frame." };
+			}
+			run(frames.size(), [&](uint64_t workerIndex, uint64_t index) {
+				workers[workerIndex]->parser.parseEtfToData(values[index], toBytes(frames[index]));
+			});
+		}
+
+		/// @brief Destructor, which stops and joins the worker threads.
+		inline ~etf_parallel_parser() {
+			{
+				std::lock_guard lock{ stateMutex };
+				stopping = true;
+			}
+			startCondition.notify_all();
+			for (auto& value: threads) {
+				value.join();
+			}
+		}
+
+	  protected:
+		/// @brief The state of one worker, which is only touched by other workers when they steal from its range.
+		struct worker {
+			etf_parser parser;///< The parser that this worker reuses between frames.
+			uninitialized_buffer<char> output{};///< The JSON produced by this worker during the current batch.
+			std::mutex rangeMutex{};///< Guards begin and end.
+			uint64_t begin{};///< The index of the first frame left in this worker's range.
+			uint64_t end{};///< The index one past the last frame left in this worker's range.
+
+			inline worker(bool checkUtf8New, uint64_t maxDepthNew) : parser{ checkUtf8New, maxDepthNew } {
+			}
+		};
+
+		/// @brief Where the JSON of one frame was written.
+		struct output_location {
+			uint64_t worker{};///< The index of the worker whose output holds the JSON.
+			uint64_t offset{};///< The offset of the JSON within the worker's output.
+			uint64_t length{};///< The length of the JSON.
+		};
+
+		std::vector<std::unique_ptr<worker>> workers{};///< The workers, the first of which is the calling thread.
+		std::vector<std::thread> threads{};///< The threads of every worker but the first.
+		std::vector<output_location> locations{};///< Where the JSON of each frame of the current batch was written.
+		std::vector<std::string_view> results{};///< The JSON of each frame of the current batch.
+		std::mutex stateMutex{};///< Guards generation, activeCount, stopping, and firstError.
+		std::condition_variable startCondition{};///< Signalled when a batch starts, or when the pool stops.
+		std::condition_variable doneCondition{};///< Signalled when the last thread finishes its part of a batch.
+		std::exception_ptr firstError{};///< The first exception thrown while parsing the current batch.
+		std::atomic<bool> failed{};///< Whether a frame of the current batch has failed, so that the rest are skipped.
+		void (*taskFunction)(void*, uint64_t, uint64_t){};///< Parses one frame on a given worker.
+		void* taskContext{};///< The state passed to taskFunction.
+		uint64_t grainSize{ 1 };///< The number of frames that a worker takes from its own range at a time.
+		uint64_t generation{};///< Incremented for every batch.
+		uint64_t activeCount{};///< The number of threads still working on the current batch.
+		bool stopping{};///< Whether the pool is being destroyed.
+
+		/// @brief View a frame as bytes.
+		/// @param frame The frame.
+		/// @return The bytes of the frame.
+		template<typename frame_type> inline static std::span<const uint8_t> toBytes(const frame_type& frame) {
+			return std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(std::data(frame)), std::size(frame) * sizeof(*std::data(frame)) };
+		}
+
+		/// @brief Run a task over every frame of a batch, across every worker, and wait for it to finish.
+		/// @param count The number of frames.
+		/// @param task The task, which is called with the index of the worker and the index of the frame.
+		template<typename task_type> inline void run(uint64_t count, task_type&& task) {
+			if (count == 0) {
+				return;
+			}
+			const uint64_t workerCount = workers.size();
+			for (uint64_t x = 0; x < workerCount; ++x) {
+				workers[x]->begin = count * x / workerCount;
+				workers[x]->end	  = count * (x + 1) / workerCount;
+			}
+			grainSize	 = std::max(count / (workerCount * 32), uint64_t{ 1 });
+			taskContext	 = &task;
+			taskFunction = [](void* context, uint64_t workerIndex, uint64_t index) {
+				(*static_cast<std::remove_reference_t<task_type>*>(context))(workerIndex, index);
+			};
+			failed.store(false, std::memory_order_relaxed);
+			{
+				std::lock_guard lock{ stateMutex };
+				firstError	= nullptr;
+				activeCount = workerCount - 1;
+				++generation;
+			}
+			startCondition.notify_all();
+			work(0);
+			std::unique_lock lock{ stateMutex };
+			doneCondition.wait(lock, [&] {
+				return activeCount == 0;
+			});
+			if (firstError) {
+				std::rethrow_exception(std::exchange(firstError, nullptr));
+			}
+		}
+
+		/// @brief The loop of each worker thread, which waits for a batch, works on it, and reports when done.
+		/// @param workerIndex The index of the worker.
+		inline void threadFunction(uint64_t workerIndex) {
+			uint64_t seenGeneration{};
+			while (true) {
+				{
+					std::unique_lock lock{ stateMutex };
+					startCondition.wait(lock, [&] {
+						return stopping || generation != seenGeneration;
+					});
+					if (stopping) {
+						return;
+					}
+					seenGeneration = generation;
+				}
+				work(workerIndex);
+				std::lock_guard lock{ stateMutex };
+				if (--activeCount == 0) {
+					doneCondition.notify_one();
+				}
+			}
+		}
+
+		/// @brief Parse frames until every worker's range is empty.
+		/// @param workerIndex The index of the worker.
+		inline void work(uint64_t workerIndex) {
+			uint64_t begin{};
+			uint64_t end{};
+			while (takeOwn(workerIndex, begin, end) || steal(workerIndex, begin, end)) {
+				for (; begin < end && !failed.load(std::memory_order_relaxed); ++begin) {
+					try {
+						taskFunction(taskContext, workerIndex, begin);
+					} catch (...) {
+						std::lock_guard lock{ stateMutex };
+						if (!firstError) {
+							firstError = std::current_exception();
+						}
+						failed.store(true, std::memory_order_relaxed);
+					}
+				}
+			}
+		}
+
+		/// @brief Take a chunk of frames from the front of a worker's own range.
+		/// @param workerIndex The index of the worker.
+		/// @param begin Set to the index of the first frame taken.
+		/// @param end Set to the index one past the last frame taken.
+		/// @return True if any frames were taken, false if the range is empty.
+		inline bool takeOwn(uint64_t workerIndex, uint64_t& begin, uint64_t& end) {
+			auto& newWorker = *workers[workerIndex];
+			std::lock_guard lock{ newWorker.rangeMutex };
+			if (newWorker.begin == newWorker.end) {
+				return false;
+			}
+			begin			= newWorker.begin;
+			end				= std::min(begin + grainSize, newWorker.end);
+			newWorker.begin = end;
+			return true;
+		}
+
+		/// @brief Steal half of the frames left in another worker's range, from its back.
+		/// @param workerIndex The index of the stealing worker.
+		/// @param begin Set to the index of the first frame stolen.
+		/// @param end Set to the index one past the last frame stolen.
+		/// @return True if any frames were stolen, false if every range is empty.
+		inline bool steal(uint64_t workerIndex, uint64_t& begin, uint64_t& end) {
+			for (uint64_t x = 1; x < workers.size(); ++x) {
+				auto& victim = *workers[(workerIndex + x) % workers.size()];
+				std::lock_guard lock{ victim.rangeMutex };
+				const uint64_t remaining = victim.end - victim.begin;
+				if (remaining > 0) {
+					end		   = victim.end;
+					begin	   = end - (remaining + 1) / 2;
+					victim.end = begin;
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+}
@@ -0,0 +1,500 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file StreamParser.hpp
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <vector>
+
+namespace CppEtfer {
+
+	/// @brief Class for parsing ETF data to JSON as it arrives, one chunk at a time.
+	/// Lists, tuples and maps are tracked on an explicit stack, so a term may be split at any byte. Scalars, atoms, pids, references and short
+	/// binaries that straddle a chunk boundary are collected until complete and then converted by etf_parser, while longer binaries are escaped
+	/// as their bytes arrive. A compressed term is inflated into a small window as its bytes arrive, and each fill of the window is parsed the
+	/// same way, which requires zlib.
+	class etf_stream_parser : protected etf_parser {
+	  public:
+		/// @brief Default constructor.
+		inline etf_stream_parser() = default;
+
+		/// @brief Constructor that sets whether strings are validated as UTF-8 while being parsed.
+		/// @param checkUtf8New Whether to throw on strings that are not well-formed UTF-8.
+		/// @param maxDepthNew The limit on how deeply lists and maps may be nested.
+		inline explicit etf_stream_parser(bool checkUtf8New, uint64_t maxDepthNew = defaultMaxDepth) : etf_parser{ checkUtf8New, maxDepthNew } {
+		}
+
+		/// @brief Parse the next chunk of a term.
+		/// @param chunk The next bytes of the ETF data.
+		/// @return The JSON produced from this chunk, valid until the next call to feed() or reset().
+		template<string_t string_type> inline std::string_view feed(string_type&& chunk) {
+			return feed(std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size() });
+		}
+
+		/// @brief Parse the next chunk of a term.
+		/// @param chunk The next bytes of the ETF data.
+		/// @return The JSON produced from this chunk, valid until the next call to feed() or reset().
+		inline std::string_view feed(std::span<const uint8_t> chunk) {
+			uint64_t consumed{};
+			const std::string_view json = feed(chunk, consumed);
+			if (consumed < chunk.size()) {
+				throw std::runtime_error{ "etf_stream_parser::feed() Error: Data past the end of the term." };
+			}
+			return json;
+		}
+
+		/// @brief Parse the next chunk of a term, stopping at the end of the term, so that a chunk holding the start of the next term can be
+		/// handed on after reset().
+		/// @param chunk The next bytes of the ETF data.
+		/// @param consumed Set to the number of bytes of the chunk that belong to the term.
+		/// @return The JSON produced from this chunk, valid until the next call to feed() or reset().
+		inline std::string_view feed(std::span<const uint8_t> chunk, uint64_t& consumed) {
+			finalString.resize(maxStreamSize(chunk.size()));
+			currentPtr = finalString.data();
+			consumed   = inflating ? inflateChunk(chunk.data(), chunk.size()) : parseChunk(chunk.data(), chunk.size());
+			return std::string_view{ finalString.data(), static_cast<uint64_t>(currentPtr - finalString.data()) };
+		}
+
+		/// @brief Check whether a complete term has been parsed.
+		/// @return True if the term is complete, false if more chunks are expected.
+		inline bool done() const {
+			return state == stream_state::Done && !inflating;
+		}
+
+		/// @brief Prepare to parse a new term, discarding any partially parsed one.
+		inline void reset() {
+			state = stream_state::Version;
+			frames.clear();
+			pending.clear();
+			utf8CarrySize = 0;
+			inflating	  = false;
+		}
+
+	  protected:
+		/// @brief The states of the parser between chunks.
+		enum class stream_state : uint8_t { Version = 0, Value = 1, Collect = 2, Stream = 3, List_Tail = 4, Done = 5, Compressed_Header = 6 };
+
+		/// @brief A list, tuple or map whose elements are still being parsed.
+		struct stream_frame {
+			uint64_t remaining{};///< The number of elements left to parse, counting keys and values separately for maps.
+			bool isMap{};///< Whether the frame is a map.
+			bool hasTail{};///< Whether the frame is a list whose tail is still to be parsed.
+		};
+
+#if defined(CPP_ETFER_ZLIB)
+		/// @brief Deleter that releases a zlib context.
+		struct inflate_stream_deleter {
+			inline void operator()(z_stream* stream) const {
+				inflateEnd(stream);
+				delete stream;
+			}
+		};
+#endif
+
+		/// @brief The length of binary beyond which a binary split across chunks is streamed instead of collected.
+		static constexpr uint64_t maxCollectedBinarySize{ 5 };
+
+		/// @brief The number of uncompressed bytes of a compressed term that are inflated before being parsed.
+		static constexpr uint64_t inflateWindowSize{ 16 * 1024 };
+
+		std::vector<stream_frame> frames{};///< The stack of lists, tuples and maps being parsed.
+		std::basic_string<uint8_t> pending{};///< The bytes of a value that straddles a chunk boundary.
+		uint64_t collectSize{};///< The number of bytes to collect into pending before they can be parsed.
+		uint64_t streamRemaining{};///< The number of bytes left in the binary being streamed.
+		uint8_t utf8Carry[4]{};///< The leading bytes of a UTF-8 sequence that was split across chunks.
+		uint8_t utf8CarrySize{};///< The number of bytes in utf8Carry.
+		stream_state state{ stream_state::Version };///< The current state of the parser.
+#if defined(CPP_ETFER_ZLIB)
+		std::unique_ptr<z_stream, inflate_stream_deleter> inflater{};///< The zlib context for compressed terms, created on first use.
+#endif
+		uninitialized_buffer<uint8_t> inflateWindow{};///< The window that a compressed term is inflated into.
+		uint64_t inflateRemaining{};///< The number of uncompressed bytes that the compressed term being parsed has yet to produce.
+		bool inflating{};///< Whether the bytes being fed are the zlib data of a compressed term.
+
+		/// @brief Run the uncompressed bytes of a term through the state machine, stopping at the end of the term.
+		/// @param data Pointer to the bytes.
+		/// @param length The number of bytes.
+		/// @return The number of bytes that belong to the term.
+		inline uint64_t parseChunk(const uint8_t* data, uint64_t length) {
+			const uint64_t startLength = length;
+			while (length > 0 && state != stream_state::Done) {
+				switch (state) {
+					case stream_state::Version: {
+						if (*data != formatVersion) {
+							throw std::runtime_error{ "etf_stream_parser::feed() Error: Incorrect format version specified." };
+						}
+						++data;
+						--length;
+						state = stream_state::Value;
+						break;
+					}
+					case stream_state::Value: {
+						const uint64_t consumed = parseValue(data, length);
+						data += consumed;
+						length -= consumed;
+						break;
+					}
+					case stream_state::Collect: {
+						const uint64_t consumed = std::min(collectSize - pending.size(), length);
+						pending.append(data, consumed);
+						data += consumed;
+						length -= consumed;
+						if (pending.size() == collectSize) {
+							parseCollected();
+						}
+						break;
+					}
+					case stream_state::Stream: {
+						const uint64_t consumed = std::min(streamRemaining, length);
+						streamBinary(data, consumed);
+						data += consumed;
+						length -= consumed;
+						streamRemaining -= consumed;
+						if (streamRemaining == 0) {
+							finishBinary();
+						}
+						break;
+					}
+					case stream_state::List_Tail: {
+						if (*data != static_cast<uint8_t>(etf_type::Nil_Ext)) {
+							writeCharacter<','>();
+							frames.back() = stream_frame{ 1, false, false };
+							state		  = stream_state::Value;
+							break;
+						}
+						++data;
+						--length;
+						writeCharacter<']'>();
+						frames.pop_back();
+						completeValue();
+						break;
+					}
+					case stream_state::Compressed_Header: {
+						const uint64_t consumed = std::min(5 - pending.size(), length);
+						pending.append(data, consumed);
+						data += consumed;
+						length -= consumed;
+						if (pending.size() == 5) {
+							beginInflate(loadBits<uint32_t>(pending.data() + 1));
+							pending.clear();
+							return startLength - length + inflateChunk(data, length);
+						}
+						break;
+					}
+					case stream_state::Done: {
+						break;
+					}
+				}
+			}
+			return startLength - length;
+		}
+
+		/// @brief Begin inflating a compressed term, once its tag and uncompressed size have been read.
+		/// @param size The declared uncompressed size.
+		inline void beginInflate(uint64_t size) {
+			if (size > maxInflatedTermSize) {
+				throw std::runtime_error{ "etf_stream_parser::feed() Error: The compressed term declares " + std::to_string(size) + " bytes, more than the limit of " +
+					std::to_string(maxInflatedTermSize) + "." };
+			}
+#if defined(CPP_ETFER_ZLIB)
+			if (!inflater) {
+				std::unique_ptr<z_stream> newInflater{ new z_stream{} };
+				if (inflateInit(newInflater.get()) != Z_OK) {
+					throw std::runtime_error{ "etf_stream_parser::feed() Error: Failed to initialize zlib." };
+				}
+				inflater.reset(newInflater.release());
+			} else {
+				inflateReset(inflater.get());
+			}
+			inflateWindow.resize(inflateWindowSize);
+			inflateRemaining = size;
+			inflating		 = true;
+			state			 = stream_state::Value;
+#else
+			throw std::runtime_error{ "etf_stream_parser::feed() Error: Compressed terms require zlib, define CPP_ETFER_ZLIB and link zlib, or configure with -DZLIB=ON." };
+#endif
+		}
+
+		/// @brief Inflate the next bytes of a compressed term, and parse each fill of the window.
+		/// @param data Pointer to the zlib data.
+		/// @param length The number of bytes of zlib data.
+		/// @return The number of bytes that belong to the term, which are all of them unless the zlib data ends first.
+		inline uint64_t inflateChunk([[maybe_unused]] const uint8_t* data, [[maybe_unused]] uint64_t length) {
+#if defined(CPP_ETFER_ZLIB)
+			if (length > UINT_MAX) {
+				throw std::runtime_error{ "etf_stream_parser::feed() Error: Chunks of a compressed term are limited to 4 GiB." };
+			}
+			inflater->next_in  = const_cast<Bytef*>(data);
+			inflater->avail_in = static_cast<uInt>(length);
+			do {
+				inflater->next_out	= inflateWindow.data();
+				inflater->avail_out = static_cast<uInt>(inflateWindow.size());
+				const int result	= inflate(inflater.get(), Z_SYNC_FLUSH);
+				if (result != Z_OK && result != Z_BUF_ERROR && result != Z_STREAM_END) {
+					throw std::runtime_error{ "etf_stream_parser::feed() Error: The compressed term is corrupt." };
+				}
+				const uint64_t produced = inflateWindow.size() - inflater->avail_out;
+				if (produced > inflateRemaining || (result == Z_STREAM_END && produced != inflateRemaining)) {
+					throw std::runtime_error{ "etf_stream_parser::feed() Error: The compressed term does not inflate to its declared size." };
+				}
+				inflateRemaining -= produced;
+				const uint64_t written = static_cast<uint64_t>(currentPtr - finalString.data());
+				finalString.resize(written + maxStreamSize(produced));
+				currentPtr = finalString.data() + written;
+				if (parseChunk(inflateWindow.data(), produced) < produced) {
+					throw std::runtime_error{ "etf_stream_parser::feed() Error: The compressed term inflates to data past the end of the term." };
+				}
+				if (result == Z_STREAM_END) {
+					if (state != stream_state::Done) {
+						throw std::runtime_error{ "etf_stream_parser::feed() Error: The compressed term ends partway through a value." };
+					}
+					inflating = false;
+				} else if (result == Z_BUF_ERROR && produced == 0) {
+					break;
+				}
+			} while (inflating && (inflater->avail_out == 0 || inflater->avail_in > 0));
+			return length - inflater->avail_in;
+#else
+			return length;
+#endif
+		}
+
+		/// @brief Compute an upper bound on the size of the JSON that a chunk can produce, including values completed from earlier chunks
+		/// and the closing brackets of any lists and maps that it finishes.
+		/// @param length The size of the chunk.
+		/// @return The maximum number of characters that parsing it can write.
+		inline uint64_t maxStreamSize(uint64_t length) const {
+			return maxJsonSize(length + pending.size() + utf8CarrySize) + frames.size() * 2 + maxNumberCharSize;
+		}
+
+		/// @brief Begin parsing a value, converting it straight out of the chunk when it is complete.
+		/// @param data Pointer to the unparsed bytes of the chunk.
+		/// @param length The number of unparsed bytes.
+		/// @return The number of bytes consumed.
+		inline uint64_t parseValue(const uint8_t* data, uint64_t length) {
+			if (data[0] == static_cast<uint8_t>(etf_type::Compressed)) {
+				if (!frames.empty() || inflating) {
+					throw std::runtime_error{ "etf_stream_parser::feed() Error: Compressed terms may only appear at the top level." };
+				}
+				state = stream_state::Compressed_Header;
+				return 0;
+			}
+			if (data[0] == static_cast<uint8_t>(etf_type::Large_Big_Ext) && length >= 5) {
+				checkBigIntegerSize(loadBits<uint32_t>(data + 1));
+			}
+			const uint64_t size = valueSize(data, length);
+			if (length < size) {
+				if (data[0] == static_cast<uint8_t>(etf_type::Binary_Ext) && length >= 5 && size - 5 > maxCollectedBinarySize) {
+					beginBinary(size - 5);
+					return 5;
+				}
+				pending.assign(data, length);
+				collectSize = size;
+				state		= stream_state::Collect;
+				return length;
+			}
+			if (beginContainer(data)) {
+				return size;
+			}
+			loadBuffer(data, size);
+			singleValueETFToJson();
+			completeValue();
+			return size;
+		}
+
+		/// @brief Handle a value once collectSize of its bytes have been collected into pending, which may still be too few to hold all of it.
+		inline void parseCollected() {
+			if (pending[0] == static_cast<uint8_t>(etf_type::Large_Big_Ext) && pending.size() >= 5) {
+				checkBigIntegerSize(loadBits<uint32_t>(pending.data() + 1));
+			}
+			const uint64_t size = valueSize(pending.data(), pending.size());
+			if (pending.size() < size) {
+				if (pending[0] == static_cast<uint8_t>(etf_type::Binary_Ext) && size - 5 > maxCollectedBinarySize) {
+					pending.clear();
+					beginBinary(size - 5);
+				} else {
+					collectSize = size;
+				}
+				return;
+			}
+			if (!beginContainer(pending.data())) {
+				loadBuffer(pending.data(), pending.size());
+				singleValueETFToJson();
+				completeValue();
+			}
+			pending.clear();
+		}
+
+		/// @brief Open a list, tuple or map, if the value is one.
+		/// @param data Pointer to the tag and complete header of the value.
+		/// @return True if the value was a list, tuple or map, false otherwise.
+		inline bool beginContainer(const uint8_t* data) {
+			switch (static_cast<etf_type>(data[0])) {
+				case etf_type::List_Ext: {
+					writeCharacter<'['>();
+					const uint64_t length = loadBits<uint32_t>(data + 1);
+					pushFrame(length, false, true);
+					state = length > 0 ? stream_state::Value : stream_state::List_Tail;
+					return true;
+				}
+				case etf_type::Small_Tuple_Ext: {
+					[[fallthrough]];
+				}
+				case etf_type::Large_Tuple_Ext: {
+					writeCharacter<'['>();
+					const uint64_t length = static_cast<etf_type>(data[0]) == etf_type::Small_Tuple_Ext ? data[1] : loadBits<uint32_t>(data + 1);
+					if (length == 0) {
+						writeCharacter<']'>();
+						completeValue();
+					} else {
+						pushFrame(length, false, false);
+						state = stream_state::Value;
+					}
+					return true;
+				}
+				case etf_type::Map_Ext: {
+					writeCharacter<'{'>();
+					const uint64_t length = loadBits<uint32_t>(data + 1);
+					if (length == 0) {
+						writeCharacter<'}'>();
+						completeValue();
+					} else {
+						pushFrame(length * 2, true, false);
+						state = stream_state::Value;
+					}
+					return true;
+				}
+				default: {
+					return false;
+				}
+			}
+		}
+
+		/// @brief Push a list, tuple or map onto the stack of frames.
+		/// @param remaining The number of elements in the container, counting keys and values separately for maps.
+		/// @param isMap Whether the container is a map.
+		/// @param hasTail Whether the container is a list, which ends with a tail.
+		inline void pushFrame(uint64_t remaining, bool isMap, bool hasTail) {
+			if (frames.size() >= maxDepth) {
+				throw std::runtime_error{ "etf_stream_parser::pushFrame() Error: Exceeded the maximum nesting depth of " + std::to_string(maxDepth) + "." };
+			}
+			frames.emplace_back(stream_frame{ remaining, isMap, hasTail });
+		}
+
+		/// @brief Begin streaming the body of a binary.
+		/// @param length The length of the binary.
+		inline void beginBinary(uint64_t length) {
+			writeCharacter<'"'>();
+			streamRemaining = length;
+			utf8CarrySize	= 0;
+			state			= stream_state::Stream;
+		}
+
+		/// @brief Escape the next bytes of the binary being streamed, holding back a trailing UTF-8 sequence that is cut off by the chunk
+		/// boundary when validating, so that it is checked once whole.
+		/// @param data Pointer to the bytes.
+		/// @param length The number of bytes.
+		inline void streamBinary(const uint8_t* data, uint64_t length) {
+			if (!checkUtf8) {
+				currentPtr = escapeString(data, length, currentPtr, false);
+				return;
+			}
+			if (utf8CarrySize > 0) {
+				const uint64_t sequenceSize = utf8Carry[0] >= 0xF0 ? 4 : utf8Carry[0] >= 0xE0 ? 3 : 2;
+				const uint64_t copySize		= std::min(sequenceSize - utf8CarrySize, length);
+				std::memcpy(utf8Carry + utf8CarrySize, data, copySize);
+				utf8CarrySize += static_cast<uint8_t>(copySize);
+				data += copySize;
+				length -= copySize;
+				if (utf8CarrySize < sequenceSize) {
+					return;
+				}
+				currentPtr	  = escapeString(utf8Carry, utf8CarrySize, currentPtr, true);
+				utf8CarrySize = 0;
+			}
+			uint64_t cutSize{};
+			for (uint64_t x = 1; x <= std::min<uint64_t>(3, length); ++x) {
+				const uint8_t value = data[length - x];
+				if ((value & 0xC0) == 0x80) {
+					continue;
+				}
+				if (value >= 0xC0 && (value >= 0xF0 ? 4 : value >= 0xE0 ? 3 : 2) > x) {
+					cutSize = x;
+				}
+				break;
+			}
+			currentPtr = escapeString(data, length - cutSize, currentPtr, true);
+			std::memcpy(utf8Carry, data + length - cutSize, cutSize);
+			utf8CarrySize = static_cast<uint8_t>(cutSize);
+		}
+
+		/// @brief Close the binary being streamed.
+		inline void finishBinary() {
+			if (utf8CarrySize > 0) {
+				currentPtr	  = escapeString(utf8Carry, utf8CarrySize, currentPtr, true);
+				utf8CarrySize = 0;
+			}
+			writeCharacter<'"'>();
+			completeValue();
+		}
+
+		/// @brief Account for a finished value in the enclosing lists, tuples and maps, writing separators and closing brackets.
+		inline void completeValue() {
+			while (!frames.empty()) {
+				auto& frame = frames.back();
+				--frame.remaining;
+				if (frame.isMap) {
+					if (frame.remaining == 0) {
+						writeCharacter<'}'>();
+						frames.pop_back();
+						continue;
+					}
+					writeCharacter((frame.remaining & 1) ? ':' : ',');
+				} else {
+					if (frame.remaining == 0) {
+						if (frame.hasTail) {
+							state = stream_state::List_Tail;
+							return;
+						}
+						writeCharacter<']'>();
+						frames.pop_back();
+						continue;
+					}
+					writeCharacter<','>();
+				}
+				state = stream_state::Value;
+				return;
+			}
+			state = stream_state::Done;
+		}
+	};
+
+}
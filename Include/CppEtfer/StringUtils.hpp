@@ -0,0 +1,233 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file StringUtils.hpp
+
+#pragma once
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <array>
+#include <bit>
+
+#if defined(__AVX2__)
+	#define CPP_ETFER_AVX2 1
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define CPP_ETFER_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+namespace CppEtfer {
+
+	/// @brief The largest number of JSON characters that a single string byte can be escaped into.
+	constexpr uint64_t maxEscapedCharSize{ 6 };
+
+	/// @brief Table of bytes that must be escaped within a JSON string.
+	constexpr auto escapeTable{ [] {
+		std::array<bool, 256> returnValues{};
+		for (uint64_t x = 0; x < 0x20; ++x) {
+			returnValues[x] = true;
+		}
+		returnValues['"']  = true;
+		returnValues['\\'] = true;
+		return returnValues;
+	}() };
+
+	/// @brief Find the next byte that must be escaped within a JSON string.
+	/// @param data Pointer to the bytes to scan.
+	/// @param length The number of bytes to scan.
+	/// @param nonAscii Set to true if any byte before the returned index has its high bit set.
+	/// @return The index of the first byte that must be escaped, or length if there is none.
+	inline uint64_t findNextEscape(const uint8_t* data, uint64_t length, bool& nonAscii) {
+		uint64_t index{};
+#if defined(CPP_ETFER_AVX2)
+		const __m256i quotes	  = _mm256_set1_epi8('"');
+		const __m256i backslashes = _mm256_set1_epi8('\\');
+		const __m256i controls	  = _mm256_set1_epi8(0x1F);
+		for (; index + 32 <= length; index += 32) {
+			const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+			const __m256i escapes =
+				_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quotes), _mm256_cmpeq_epi8(chunk, backslashes)), _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, controls), chunk));
+			const uint32_t escapeMask = static_cast<uint32_t>(_mm256_movemask_epi8(escapes));
+			const uint32_t highMask	  = static_cast<uint32_t>(_mm256_movemask_epi8(chunk));
+			if (escapeMask) {
+				const uint32_t escapeIndex = static_cast<uint32_t>(std::countr_zero(escapeMask));
+				nonAscii |= (highMask & ((1ull << escapeIndex) - 1)) != 0;
+				return index + escapeIndex;
+			}
+			nonAscii |= highMask != 0;
+		}
+#elif defined(CPP_ETFER_SSE2)
+		const __m128i quotes	  = _mm_set1_epi8('"');
+		const __m128i backslashes = _mm_set1_epi8('\\');
+		const __m128i controls	  = _mm_set1_epi8(0x1F);
+		for (; index + 16 <= length; index += 16) {
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+			const __m128i escapes =
+				_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quotes), _mm_cmpeq_epi8(chunk, backslashes)), _mm_cmpeq_epi8(_mm_min_epu8(chunk, controls), chunk));
+			const uint32_t escapeMask = static_cast<uint32_t>(_mm_movemask_epi8(escapes));
+			const uint32_t highMask	  = static_cast<uint32_t>(_mm_movemask_epi8(chunk));
+			if (escapeMask) {
+				const uint32_t escapeIndex = static_cast<uint32_t>(std::countr_zero(escapeMask));
+				nonAscii |= (highMask & ((1u << escapeIndex) - 1)) != 0;
+				return index + escapeIndex;
+			}
+			nonAscii |= highMask != 0;
+		}
+#endif
+		for (; index < length; ++index) {
+			if (escapeTable[data[index]]) {
+				return index;
+			}
+			nonAscii |= data[index] >= 0x80;
+		}
+		return index;
+	}
+
+	/// @brief Check that a sequence of bytes is well-formed UTF-8.
+	/// @param data Pointer to the bytes to check.
+	/// @param length The number of bytes to check.
+	/// @return True if the bytes are well-formed UTF-8, false otherwise.
+	inline bool validateUtf8(const uint8_t* data, uint64_t length) {
+		uint64_t index{};
+		while (index < length) {
+			if (index + 8 <= length) {
+				uint64_t block{};
+				std::memcpy(&block, data + index, sizeof(block));
+				if ((block & 0x8080808080808080ull) == 0) {
+					index += 8;
+					continue;
+				}
+			}
+			const uint8_t leadByte = data[index];
+			if (leadByte < 0x80) {
+				++index;
+				continue;
+			}
+			uint64_t continuationCount{};
+			uint8_t lowerBound{ 0x80 };
+			uint8_t upperBound{ 0xBF };
+			if (leadByte >= 0xC2 && leadByte <= 0xDF) {
+				continuationCount = 1;
+			} else if (leadByte >= 0xE0 && leadByte <= 0xEF) {
+				continuationCount = 2;
+				lowerBound		  = leadByte == 0xE0 ? 0xA0 : 0x80;
+				upperBound		  = leadByte == 0xED ? 0x9F : 0xBF;
+			} else if (leadByte >= 0xF0 && leadByte <= 0xF4) {
+				continuationCount = 3;
+				lowerBound		  = leadByte == 0xF0 ? 0x90 : 0x80;
+				upperBound		  = leadByte == 0xF4 ? 0x8F : 0xBF;
+			} else {
+				return false;
+			}
+			if (index + continuationCount >= length) {
+				return false;
+			}
+			if (data[index + 1] < lowerBound || data[index + 1] > upperBound) {
+				return false;
+			}
+			for (uint64_t x = 2; x <= continuationCount; ++x) {
+				if ((data[index + x] & 0xC0) != 0x80) {
+					return false;
+				}
+			}
+			index += continuationCount + 1;
+		}
+		return true;
+	}
+
+	/// @brief Write a single escaped byte into a JSON string.
+	/// @param out Pointer to the output, which must have room for maxEscapedCharSize characters.
+	/// @param value The byte to escape.
+	/// @return Pointer to one past the last written character.
+	inline char* writeEscapedChar(char* out, uint8_t value) {
+		static constexpr char hexDigits[]{ "0123456789abcdef" };
+		out[0] = '\\';
+		switch (value) {
+			case '"': {
+				out[1] = '"';
+				return out + 2;
+			}
+			case '\\': {
+				out[1] = '\\';
+				return out + 2;
+			}
+			case '\b': {
+				out[1] = 'b';
+				return out + 2;
+			}
+			case '\f': {
+				out[1] = 'f';
+				return out + 2;
+			}
+			case '\n': {
+				out[1] = 'n';
+				return out + 2;
+			}
+			case '\r': {
+				out[1] = 'r';
+				return out + 2;
+			}
+			case '\t': {
+				out[1] = 't';
+				return out + 2;
+			}
+			default: {
+				std::memcpy(out + 1, "u00", 3);
+				out[4] = hexDigits[value >> 4];
+				out[5] = hexDigits[value & 0x0F];
+				return out + 6;
+			}
+		}
+	}
+
+	/// @brief Escape a sequence of bytes into the body of a JSON string, copying clean runs in bulk.
+	/// @param data Pointer to the bytes to escape.
+	/// @param length The number of bytes to escape.
+	/// @param out Pointer to the output, which must have room for length * maxEscapedCharSize characters.
+	/// @param checkUtf8 Whether to validate that the bytes are well-formed UTF-8.
+	/// @return Pointer to one past the last written character.
+	inline char* escapeString(const uint8_t* data, uint64_t length, char* out, bool checkUtf8) {
+		while (length > 0) {
+			bool nonAscii{};
+			const uint64_t runLength = findNextEscape(data, length, nonAscii);
+			if (checkUtf8 && nonAscii && !validateUtf8(data, runLength)) {
+				throw std::runtime_error{ "escapeString() Error: Invalid UTF-8 in string." };
+			}
+			std::memcpy(out, data, runLength);
+			out += runLength;
+			if (runLength == length) {
+				break;
+			}
+			out = writeEscapedChar(out, data[runLength]);
+			data += runLength + 1;
+			length -= runLength + 1;
+		}
+		return out;
+	}
+
+}
@@ -0,0 +1,336 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Template.hpp
+
+#pragma once
+
+#include <CppEtfer/Constant.hpp>
+
+#include <string_view>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <bit>
+
+namespace CppEtfer {
+
+	/// @brief The kinds of value that a slot of an etf_template holds.
+	enum class etf_slot_type : uint8_t {
+		integer = 0,///< An 8-byte Small_Big_Ext, which holds any int64_t or uint64_t.
+		floating = 1,///< A New_Float_Ext.
+		boolean = 2,///< The atom true or false.
+		string = 3,///< A Binary_Ext of at most a fixed capacity.
+	};
+
+	/// @brief A slot of an etf_template, whose value can be replaced in place.
+	struct etf_template_slot {
+		uint64_t offset{};///< The offset of the slot's tag in the encoded payload.
+		uint64_t size{};///< The number of bytes that the slot's value currently occupies.
+		uint32_t capacity{};///< The largest number of bytes that a string slot holds.
+		etf_slot_type type{};///< The kind of value that the slot holds.
+	};
+
+	/// @brief The encoded size of an integer slot: the tag, the byte count, the sign and 8 bytes of magnitude.
+	constexpr uint64_t integerSlotSize{ 11 };
+
+	/// @brief The encoded size of a floating-point slot: the tag and 8 bytes.
+	constexpr uint64_t floatSlotSize{ 9 };
+
+	/// @brief Write an integer in the fixed-width form used by integer slots.
+	/// @param newPtr Pointer to the integerSlotSize bytes to write.
+	/// @param negative Whether the value is negative.
+	/// @param magnitude The magnitude of the value.
+	constexpr void storeIntegerSlot(uint8_t* newPtr, bool negative, uint64_t magnitude) {
+		newPtr[0] = static_cast<uint8_t>(etf_type::Small_Big_Ext);
+		newPtr[1] = 8;
+		newPtr[2] = negative ? 1 : 0;
+		for (uint64_t x = 0; x < 8; ++x) {
+			newPtr[3 + x] = static_cast<uint8_t>(magnitude >> (8 * x));
+		}
+	}
+
+	/// @brief Write a boolean atom.
+	/// @param newPtr Pointer to the bytes to write.
+	/// @param value The value.
+	/// @return The number of bytes written.
+	constexpr uint64_t storeBoolSlot(uint8_t* newPtr, bool value) {
+		constexpr std::string_view names[2]{ "false", "true" };
+		const std::string_view name = names[value];
+		newPtr[0]					= static_cast<uint8_t>(etf_type::Small_Atom_Ext);
+		newPtr[1]					= static_cast<uint8_t>(name.size());
+		for (uint64_t x = 0; x < name.size(); ++x) {
+			newPtr[2 + x] = static_cast<uint8_t>(name[x]);
+		}
+		return 2 + name.size();
+	}
+
+	/// @brief A term that an etf_template records as a slot, and that other writers encode as its initial value.
+	struct etf_slot_term {
+		std::string_view stringValue{};///< The initial value of a string slot.
+		double floatValue{};///< The initial value of a floating-point slot.
+		uint64_t magnitude{};///< The magnitude of the initial value of an integer slot.
+		uint32_t capacity{};///< The largest number of bytes that a string slot holds.
+		etf_slot_type type{};///< The kind of value that the slot holds.
+		bool negative{};///< Whether the initial value of an integer slot is negative.
+		bool boolValue{};///< The initial value of a boolean slot.
+
+		/// @brief Encode the initial value, first telling the writer where the slot starts if it records slots.
+		/// @param writer The writer to append to.
+		template<typename writer_type> constexpr void encode(writer_type& writer) const {
+			if constexpr (requires { writer.beginSlot(*this); }) {
+				writer.beginSlot(*this);
+			}
+			uint8_t newBuffer[integerSlotSize]{};
+			switch (type) {
+				case etf_slot_type::integer: {
+					storeIntegerSlot(newBuffer, negative, magnitude);
+					writer.write(newBuffer, integerSlotSize);
+					break;
+				}
+				case etf_slot_type::floating: {
+					newBuffer[0] = static_cast<uint8_t>(etf_type::New_Float_Ext);
+					storeBits(newBuffer + 1, std::bit_cast<uint64_t>(floatValue));
+					writer.write(newBuffer, floatSlotSize);
+					break;
+				}
+				case etf_slot_type::boolean: {
+					writer.write(newBuffer, storeBoolSlot(newBuffer, boolValue));
+					break;
+				}
+				case etf_slot_type::string: {
+					newBuffer[0] = static_cast<uint8_t>(etf_type::Binary_Ext);
+					storeBits(newBuffer + 1, static_cast<uint32_t>(stringValue.size()));
+					writer.write(newBuffer, 5);
+					writer.write(stringValue.data(), stringValue.size());
+					break;
+				}
+			}
+		}
+	};
+
+	/// @brief Describe an integer slot of an etf_template.
+	/// @param initial The initial value.
+	/// @return The slot.
+	template<integer_t value_type = int64_t> constexpr etf_slot_term etfIntegerSlot(value_type initial = 0) {
+		etf_slot_term slot{ .type = etf_slot_type::integer };
+		slot.negative  = initial < 0;
+		slot.magnitude = slot.negative ? 0 - static_cast<uint64_t>(initial) : static_cast<uint64_t>(initial);
+		return slot;
+	}
+
+	/// @brief Describe a floating-point slot of an etf_template.
+	/// @param initial The initial value.
+	/// @return The slot.
+	constexpr etf_slot_term etfFloatSlot(double initial = 0.0) {
+		return etf_slot_term{ .floatValue = initial, .type = etf_slot_type::floating };
+	}
+
+	/// @brief Describe a boolean slot of an etf_template.
+	/// @param initial The initial value.
+	/// @return The slot.
+	constexpr etf_slot_term etfBoolSlot(bool initial = false) {
+		return etf_slot_term{ .type = etf_slot_type::boolean, .boolValue = initial };
+	}
+
+	/// @brief Describe a string slot of an etf_template.
+	/// @param capacity The largest number of bytes that the slot holds.
+	/// @param initial The initial value.
+	/// @return The slot.
+	constexpr etf_slot_term etfStringSlot(uint32_t capacity, std::string_view initial = {}) {
+		return etf_slot_term{ .stringValue = initial, .capacity = capacity, .type = etf_slot_type::string };
+	}
+
+	/// @brief Class holding a payload that is encoded once, and whose slots are then patched in place.
+	/// Integer and floating-point slots have a fixed width, so setting one is a type check and a few stores. String and boolean slots move the
+	/// bytes after them when their length changes, but the storage is sized for every string at its capacity up front, so setting one never
+	/// allocates.
+	class etf_template {
+	  public:
+		/// @brief Default constructor.
+		inline etf_template() = default;
+
+		/// @brief Encode a payload, recording the position of each of its slots.
+		/// @param term The payload, built from etfMap(), etfList(), literal values and the etf*Slot() functions.
+		template<typename term_type> inline explicit etf_template(const term_type& term) {
+			template_writer writer{ this };
+			writer.write(&formatVersion, 1);
+			etf_constant_encoder::writeTerm(writer, term);
+			uint64_t extraCapacity{};
+			for (auto& slot: slots) {
+				if (slot.type == etf_slot_type::string) {
+					if (slot.size - 5 > slot.capacity) {
+						throw std::length_error{ "etf_template::etf_template() Error: The initial value of a string slot exceeds its capacity." };
+					}
+					extraCapacity += slot.capacity + 5 - slot.size;
+				} else if (slot.type == etf_slot_type::boolean) {
+					++extraCapacity;
+				}
+			}
+			buffer.reserve(buffer.size() + extraCapacity);
+		}
+
+		/// @brief Set the value of an integer slot.
+		/// @param index The index of the slot, counting in the order that the slots appear in the payload.
+		/// @param value The new value.
+		template<integer_t value_type> inline void set(uint64_t index, value_type value) {
+			auto& slot = checkSlot(index, etf_slot_type::integer);
+			if constexpr (signed_t<value_type>) {
+				storeIntegerSlot(buffer.data() + slot.offset, value < 0, value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value));
+			} else {
+				storeIntegerSlot(buffer.data() + slot.offset, false, static_cast<uint64_t>(value));
+			}
+		}
+
+		/// @brief Set the value of a floating-point slot.
+		/// @param index The index of the slot, counting in the order that the slots appear in the payload.
+		/// @param value The new value.
+		template<float_t value_type> inline void set(uint64_t index, value_type value) {
+			auto& slot = checkSlot(index, etf_slot_type::floating);
+			storeBits(buffer.data() + slot.offset + 1, std::bit_cast<uint64_t>(static_cast<double>(value)));
+		}
+
+		/// @brief Set the value of a boolean slot.
+		/// @param index The index of the slot, counting in the order that the slots appear in the payload.
+		/// @param value The new value.
+		template<bool_t value_type> inline void set(uint64_t index, value_type value) {
+			auto& slot = checkSlot(index, etf_slot_type::boolean);
+			resizeSlot(index, value ? 6 : 7);
+			storeBoolSlot(buffer.data() + slot.offset, value);
+		}
+
+		/// @brief Set the value of a string slot.
+		/// @param index The index of the slot, counting in the order that the slots appear in the payload.
+		/// @param value The new value, of at most the slot's capacity.
+		template<string_t value_type> inline void set(uint64_t index, const value_type& value) {
+			auto& slot = checkSlot(index, etf_slot_type::string);
+			if (value.size() > slot.capacity) {
+				throw std::length_error{ "etf_template::set() Error: The string holds " + std::to_string(value.size()) + " bytes, but the slot's capacity is " +
+					std::to_string(slot.capacity) + "." };
+			}
+			resizeSlot(index, 5 + value.size());
+			storeBits(buffer.data() + slot.offset + 1, static_cast<uint32_t>(value.size()));
+			if (value.size() > 0) {
+				std::memcpy(buffer.data() + slot.offset + 5, value.data(), value.size());
+			}
+		}
+
+		/// @brief Set the value of a string slot.
+		/// @param index The index of the slot, counting in the order that the slots appear in the payload.
+		/// @param value The new value, of at most the slot's capacity.
+		inline void set(uint64_t index, const char* value) {
+			set(index, std::string_view{ value });
+		}
+
+		/// @brief Get the encoded payload, including the format version.
+		/// @return The payload, valid until the next call to set() or until this template is destroyed.
+		inline std::span<const uint8_t> data() const {
+			return std::span<const uint8_t>{ buffer.data(), buffer.size() };
+		}
+
+		/// @brief Get the slots of the payload, in the order that they appear.
+		/// @return The slots.
+		inline std::span<const etf_template_slot> getSlots() const {
+			return slots;
+		}
+
+	  protected:
+		/// @brief Writer that appends to the buffer and records each slot as it starts.
+		struct template_writer {
+			etf_template* owner{};///< The template being encoded.
+
+			template<typename value_type> inline void write(const value_type* data, uint64_t length) {
+				owner->buffer.append(reinterpret_cast<const uint8_t*>(data), length);
+			}
+
+			inline void beginSlot(const etf_slot_term& slot) {
+				uint64_t size{};
+				switch (slot.type) {
+					case etf_slot_type::integer: {
+						size = integerSlotSize;
+						break;
+					}
+					case etf_slot_type::floating: {
+						size = floatSlotSize;
+						break;
+					}
+					case etf_slot_type::boolean: {
+						size = slot.boolValue ? 6 : 7;
+						break;
+					}
+					case etf_slot_type::string: {
+						size = 5 + slot.stringValue.size();
+						break;
+					}
+				}
+				owner->slots.emplace_back(etf_template_slot{ owner->buffer.size(), size, slot.capacity, slot.type });
+			}
+		};
+
+		uninitialized_buffer<uint8_t> buffer{};///< The encoded payload.
+		std::vector<etf_template_slot> slots{};///< The slots, in the order that they appear.
+
+		/// @brief Get a slot, checking that it exists and holds the expected kind of value.
+		/// @param index The index of the slot.
+		/// @param type The kind of value that is to be stored.
+		/// @return A reference to the slot.
+		inline etf_template_slot& checkSlot(uint64_t index, etf_slot_type type) {
+			if (index >= slots.size()) {
+				throw std::out_of_range{ "etf_template::set() Error: There is no slot " + std::to_string(index) + "." };
+			}
+			if (slots[index].type != type) {
+				throw std::runtime_error{ "etf_template::set() Error: Slot " + std::to_string(index) + " holds a different type of value." };
+			}
+			return slots[index];
+		}
+
+		/// @brief Change the number of bytes that a slot occupies, moving the bytes after it and the offsets of the slots after it.
+		/// @param index The index of the slot.
+		/// @param newSize The new number of bytes.
+		inline void resizeSlot(uint64_t index, uint64_t newSize) {
+			auto& slot = slots[index];
+			if (newSize == slot.size) {
+				return;
+			}
+			const uint64_t oldEnd	= slot.offset + slot.size;
+			const uint64_t tailSize = buffer.size() - oldEnd;
+			const uint64_t oldSize	= buffer.size();
+			if (newSize > slot.size) {
+				buffer.resize(oldSize + newSize - slot.size);
+			}
+			std::memmove(buffer.data() + slot.offset + newSize, buffer.data() + oldEnd, tailSize);
+			if (newSize < slot.size) {
+				buffer.resize(oldSize - (slot.size - newSize));
+			}
+			for (uint64_t x = index + 1; x < slots.size(); ++x) {
+				slots[x].offset = slots[x].offset + newSize - slot.size;
+			}
+			slot.size = newSize;
+		}
+	};
+
+}
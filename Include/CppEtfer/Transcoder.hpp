@@ -0,0 +1,474 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Transcoder.hpp
+
+#pragma once
+
+#include <CppEtfer/CppEtfer.hpp>
+
+#include <string_view>
+#include <stdexcept>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+namespace CppEtfer {
+
+	/// @brief The most ETF bytes that one byte of JSON transcodes to. Nested arrays and floats such as [1.5] reach it: two brackets become a
+	/// List_Ext header and a Nil_Ext, and three characters become a New_Float_Ext.
+	constexpr uint64_t maxEtfBytesPerJsonByte{ 3 };
+
+	/// @brief Transcodes JSON to ETF in a single pass, writing each tag as it is scanned rather than building an etf_serializer tree.
+	/// Objects and arrays are written with a placeholder count, which is patched once they close, so the output is sized once from an upper
+	/// bound and then written without any further checks. The output matches what etf_serializer writes for the same data: strings and keys
+	/// are Binary_Exts, integers use the smallest ETF integer type that holds them, other numbers are New_Float_Exts, true, false and null are
+	/// atoms, and empty arrays are Nil_Exts.
+	struct etf_json_transcoder {
+		/// @brief An object or array whose elements are still being transcoded.
+		struct transcode_frame {
+			uint64_t headerOffset{};///< The offset of the object's or array's header in the output.
+			uint32_t count{};///< The number of elements, or of key/value pairs, transcoded so far.
+			bool object{};///< Whether this is an object rather than an array.
+		};
+
+		/// @brief Transcode JSON to ETF, including the format version, onto the end of a buffer.
+		/// The buffer is grown once, by maxEtfBytesPerJsonByte times the size of the JSON, and then shrunk to fit. With an uninitialized_buffer the
+		/// appended bytes are not zero-filled before being written.
+		/// @tparam buffer_type The type of the buffer, which must provide size(), resize() and data() over bytes.
+		/// @param json The JSON to transcode.
+		/// @param buffer The buffer to append to, which is left unchanged if the JSON is invalid.
+		/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+		template<typename buffer_type> inline static void transcodeAppend(std::string_view json, buffer_type& buffer, uint64_t maxDepth) {
+			const frame_timer timer{};
+			const uint64_t oldSize = buffer.size();
+			buffer.resize(oldSize + maxEtfBytesPerJsonByte * json.size() + 1);
+			uint64_t depth{};
+			uint64_t size{};
+			try {
+				etf_json_transcoder transcoder{ json, reinterpret_cast<uint8_t*>(buffer.data()) + oldSize, maxDepth };
+				depth = transcoder.transcode();
+				size  = static_cast<uint64_t>(transcoder.writer.currentPtr - (reinterpret_cast<uint8_t*>(buffer.data()) + oldSize));
+			} catch (...) {
+				buffer.resize(oldSize);
+				throw;
+			}
+			buffer.resize(oldSize + size);
+			timer.finish(etf_frame_kind::serialize, json.size(), size, depth);
+		}
+
+	  protected:
+		const char* iter{};///< The next character of JSON to be read.
+		const char* end{};///< One past the last character of JSON.
+		const char* begin{};///< The first character of JSON, for reporting the offsets of errors.
+		uint8_t* start{};///< The start of the output.
+		etf_serializer::pointer_writer writer{};///< The writer for the output, which has already been sized to fit.
+		uint64_t maxDepth{};///< The limit on how deeply objects and arrays may be nested.
+
+		inline etf_json_transcoder(std::string_view json, uint8_t* newPtr, uint64_t maxDepthNew)
+			: iter{ json.data() }, end{ json.data() + json.size() }, begin{ json.data() }, start{ newPtr }, writer{ newPtr }, maxDepth{ maxDepthNew } {
+		}
+
+		/// @brief Get the stack of objects and arrays being transcoded, which is reused between calls on the same thread.
+		/// @return A reference to the stack.
+		inline static std::vector<transcode_frame>& transcodeStack() {
+			thread_local std::vector<transcode_frame> stack{};
+			return stack;
+		}
+
+		/// @brief Throw an error, reporting the offset of the character being read.
+		/// @param message The description of the error.
+		[[noreturn]] inline void throwError(std::string_view message) const {
+			throw std::runtime_error{ "etf_json_transcoder::transcode() Error: " + std::string{ message } + " At offset " + std::to_string(iter - begin) + "." };
+		}
+
+		/// @brief Get the character being read, or '\0' at the end of the JSON.
+		/// @return The character.
+		inline char current() const {
+			return iter < end ? *iter : '\0';
+		}
+
+		/// @brief Skip the whitespace that JSON allows between tokens.
+		inline void skipWhitespace() {
+			while (iter < end && (*iter == ' ' || *iter == '\n' || *iter == '\r' || *iter == '\t')) {
+				++iter;
+			}
+		}
+
+		/// @brief Consume a character, which must be the expected one.
+		/// @param value The expected character.
+		inline void expect(char value) {
+			if (current() != value) {
+				throwError(std::string{ "Expected '" } + value + "'.");
+			}
+			++iter;
+		}
+
+		/// @brief Transcode the whole of the JSON, including the format version.
+		/// @return The deepest nesting reached.
+		inline uint64_t transcode() {
+			auto& stack = transcodeStack();
+			stack.clear();
+			uint64_t depth{};
+			etf_serializer::appendVersion(writer);
+			skipWhitespace();
+			while (true) {
+				if (transcodeValueOrOpen(stack)) {
+					depth = std::max<uint64_t>(depth, stack.size());
+					continue;
+				}
+				while (true) {
+					if (stack.empty()) {
+						skipWhitespace();
+						if (iter != end) {
+							throwError("Unexpected characters after the end of the JSON.");
+						}
+						return depth;
+					}
+					auto& frame = stack.back();
+					++frame.count;
+					skipWhitespace();
+					if (current() == ',') {
+						++iter;
+						skipWhitespace();
+						if (frame.object) {
+							transcodeKey();
+						}
+						break;
+					} else if (current() == (frame.object ? '}' : ']')) {
+						++iter;
+						storeBits(start + frame.headerOffset + 1, frame.count);
+						if (!frame.object) {
+							etf_serializer::appendNilExt(writer);
+						}
+						stack.pop_back();
+					} else {
+						throwError(frame.object ? "Expected ',' or '}'." : "Expected ',' or ']'.");
+					}
+				}
+			}
+		}
+
+		/// @brief Transcode a scalar value or an empty object or array, or open an object or array and move to its first value.
+		/// @param stack The stack of objects and arrays being transcoded.
+		/// @return True if an object or array was opened and its first value is next, false if a complete value was transcoded.
+		inline bool transcodeValueOrOpen(std::vector<transcode_frame>& stack) {
+			switch (current()) {
+				case '{':
+				case '[': {
+					const bool object = *iter == '{';
+					if (stack.size() >= maxDepth) {
+						throwError("Exceeded the maximum nesting depth of " + std::to_string(maxDepth) + ".");
+					}
+					++iter;
+					skipWhitespace();
+					const uint64_t headerOffset = static_cast<uint64_t>(writer.currentPtr - start);
+					if (object) {
+						etf_serializer::appendMapHeader(writer, 0);
+						if (current() == '}') {
+							++iter;
+							return false;
+						}
+						stack.emplace_back(transcode_frame{ headerOffset, 0, true });
+						transcodeKey();
+					} else {
+						if (current() == ']') {
+							++iter;
+							etf_serializer::appendNilExt(writer);
+							return false;
+						}
+						etf_serializer::appendListHeader(writer, 0);
+						stack.emplace_back(transcode_frame{ headerOffset, 0, false });
+					}
+					return true;
+				}
+				case '"': {
+					transcodeString();
+					return false;
+				}
+				case 't': {
+					transcodeLiteral("true");
+					etf_serializer::appendBool(writer, true);
+					return false;
+				}
+				case 'f': {
+					transcodeLiteral("false");
+					etf_serializer::appendBool(writer, false);
+					return false;
+				}
+				case 'n': {
+					transcodeLiteral("null");
+					etf_serializer::appendNil(writer);
+					return false;
+				}
+				case '-':
+				case '0':
+				case '1':
+				case '2':
+				case '3':
+				case '4':
+				case '5':
+				case '6':
+				case '7':
+				case '8':
+				case '9': {
+					transcodeNumber();
+					return false;
+				}
+				default: {
+					throwError(iter == end ? "Unexpected end of the JSON." : "Expected a value.");
+				}
+			}
+		}
+
+		/// @brief Transcode an object's key as a Binary_Ext, along with the colon after it.
+		inline void transcodeKey() {
+			if (current() != '"') {
+				throwError("Expected a key.");
+			}
+			transcodeString();
+			skipWhitespace();
+			expect(':');
+			skipWhitespace();
+		}
+
+		/// @brief Consume a literal, which must be spelled out in full.
+		/// @param literal The literal.
+		inline void transcodeLiteral(std::string_view literal) {
+			if (static_cast<uint64_t>(end - iter) < literal.size() || std::string_view{ iter, literal.size() } != literal) {
+				throwError("Expected '" + std::string{ literal } + "'.");
+			}
+			iter += literal.size();
+		}
+
+		/// @brief Transcode a string as a Binary_Ext, unescaping it directly into the output, which it never grows past the size of.
+		inline void transcodeString() {
+			++iter;
+			uint8_t* header = writer.currentPtr;
+			writer.currentPtr += 5;
+			header[0] = static_cast<uint8_t>(etf_type::Binary_Ext);
+			while (true) {
+				bool nonAscii{};
+				const uint64_t length = findNextEscape(reinterpret_cast<const uint8_t*>(iter), static_cast<uint64_t>(end - iter), nonAscii);
+				if (nonAscii && !validateUtf8(reinterpret_cast<const uint8_t*>(iter), length)) {
+					throwError("Invalid UTF-8 in a string.");
+				}
+				writer.write(iter, length);
+				iter += length;
+				if (iter == end) {
+					throwError("Unterminated string.");
+				} else if (*iter == '"') {
+					++iter;
+					break;
+				} else if (*iter == '\\') {
+					++iter;
+					transcodeEscape();
+				} else {
+					throwError("Unescaped control character in a string.");
+				}
+			}
+			storeBits(header + 1, static_cast<uint32_t>(writer.currentPtr - header - 5));
+		}
+
+		/// @brief Read the four hexadecimal digits of a \u escape.
+		/// @return The UTF-16 code unit.
+		inline uint32_t readHexQuad() {
+			if (end - iter < 4) {
+				throwError("Incomplete \\u escape.");
+			}
+			uint32_t value{};
+			for (uint64_t x = 0; x < 4; ++x) {
+				const char digit = iter[x];
+				value <<= 4;
+				if (digit >= '0' && digit <= '9') {
+					value |= static_cast<uint32_t>(digit - '0');
+				} else if (digit >= 'a' && digit <= 'f') {
+					value |= static_cast<uint32_t>(digit - 'a' + 10);
+				} else if (digit >= 'A' && digit <= 'F') {
+					value |= static_cast<uint32_t>(digit - 'A' + 10);
+				} else {
+					throwError("Invalid hexadecimal digit in a \\u escape.");
+				}
+			}
+			iter += 4;
+			return value;
+		}
+
+		/// @brief Transcode the escape sequence after a backslash, writing it as UTF-8.
+		inline void transcodeEscape() {
+			uint8_t newBuffer[4]{};
+			switch (current()) {
+				case '"':
+				case '\\':
+				case '/': {
+					newBuffer[0] = static_cast<uint8_t>(*iter);
+					break;
+				}
+				case 'b': {
+					newBuffer[0] = '\b';
+					break;
+				}
+				case 'f': {
+					newBuffer[0] = '\f';
+					break;
+				}
+				case 'n': {
+					newBuffer[0] = '\n';
+					break;
+				}
+				case 'r': {
+					newBuffer[0] = '\r';
+					break;
+				}
+				case 't': {
+					newBuffer[0] = '\t';
+					break;
+				}
+				case 'u': {
+					++iter;
+					uint32_t codePoint = readHexQuad();
+					if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+						throwError("Unpaired low surrogate in a \\u escape.");
+					} else if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+						if (end - iter < 2 || iter[0] != '\\' || iter[1] != 'u') {
+							throwError("Unpaired high surrogate in a \\u escape.");
+						}
+						iter += 2;
+						const uint32_t low = readHexQuad();
+						if (low < 0xDC00 || low > 0xDFFF) {
+							throwError("Unpaired high surrogate in a \\u escape.");
+						}
+						codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+					}
+					if (codePoint < 0x80) {
+						newBuffer[0] = static_cast<uint8_t>(codePoint);
+						writer.write(newBuffer, 1);
+					} else if (codePoint < 0x800) {
+						newBuffer[0] = static_cast<uint8_t>(0xC0 | (codePoint >> 6));
+						newBuffer[1] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+						writer.write(newBuffer, 2);
+					} else if (codePoint < 0x10000) {
+						newBuffer[0] = static_cast<uint8_t>(0xE0 | (codePoint >> 12));
+						newBuffer[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+						newBuffer[2] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+						writer.write(newBuffer, 3);
+					} else {
+						newBuffer[0] = static_cast<uint8_t>(0xF0 | (codePoint >> 18));
+						newBuffer[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F));
+						newBuffer[2] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+						newBuffer[3] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+						writer.write(newBuffer, 4);
+					}
+					return;
+				}
+				default: {
+					throwError("Invalid escape sequence in a string.");
+				}
+			}
+			++iter;
+			writer.write(newBuffer, 1);
+		}
+
+		/// @brief Transcode a number, as the smallest ETF integer type that holds it if it is an integer that fits in 64 bits, and as a
+		/// New_Float_Ext otherwise.
+		inline void transcodeNumber() {
+			const char* numberStart = iter;
+			const bool negative		= *iter == '-';
+			if (negative) {
+				++iter;
+			}
+			auto isDigit = [this] {
+				return iter < end && *iter >= '0' && *iter <= '9';
+			};
+			if (!isDigit()) {
+				throwError("Expected a digit.");
+			}
+			uint64_t magnitude{};
+			bool overflow{};
+			if (*iter == '0') {
+				++iter;
+			} else {
+				while (isDigit()) {
+					const uint64_t digit = static_cast<uint64_t>(*iter - '0');
+					overflow |= magnitude > (std::numeric_limits<uint64_t>::max() - digit) / 10;
+					magnitude = magnitude * 10 + digit;
+					++iter;
+				}
+			}
+			bool integer{ true };
+			if (current() == '.') {
+				integer = false;
+				++iter;
+				if (!isDigit()) {
+					throwError("Expected a digit after the decimal point.");
+				}
+				while (isDigit()) {
+					++iter;
+				}
+			}
+			if (current() == 'e' || current() == 'E') {
+				integer = false;
+				++iter;
+				if (current() == '+' || current() == '-') {
+					++iter;
+				}
+				if (!isDigit()) {
+					throwError("Expected a digit in the exponent.");
+				}
+				while (isDigit()) {
+					++iter;
+				}
+			}
+			if (integer && !overflow) {
+				if (!negative) {
+					etf_serializer::writeEtfUint(writer, magnitude);
+					return;
+				} else if (magnitude <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1) {
+					etf_serializer::writeEtfInt(writer, static_cast<int64_t>(0 - magnitude));
+					return;
+				}
+			}
+			double value{};
+			const auto result = std::from_chars(numberStart, iter, value);
+			if (result.ec != std::errc{} || result.ptr != iter) {
+				iter = numberStart;
+				throwError("Number out of the range of a double.");
+			}
+			etf_serializer::appendNewFloatExt(writer, value);
+		}
+	};
+
+	/// @brief Transcode JSON to ETF in a single pass, without building an etf_serializer tree.
+	/// @tparam buffer_type The type of the output buffer, which must provide size(), resize(), clear() and data() over bytes.
+	/// @param json The JSON to transcode.
+	/// @param buffer The buffer to write the ETF data into, its previous contents are replaced.
+	/// @param maxDepth The limit on how deeply objects and arrays may be nested.
+	template<typename buffer_type> inline void transcodeJsonToEtf(std::string_view json, buffer_type& buffer, uint64_t maxDepth = defaultMaxDepth) {
+		buffer.clear();
+		etf_json_transcoder::transcodeAppend(json, buffer, maxDepth);
+	}
+
+}
@@ -0,0 +1,82 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file Zlib.hpp
+
+#pragma once
+
+#include <stdexcept>
+#include <cstdint>
+#include <climits>
+#include <string>
+
+#if defined(CPP_ETFER_ZLIB)
+	#include <zlib.h>
+#endif
+
+namespace CppEtfer {
+
+#if defined(CPP_ETFER_ZLIB)
+	/// @brief Whether compressed terms can be decoded, set by defining CPP_ETFER_ZLIB before including CppEtfer and linking zlib.
+	constexpr bool zlibEnabled{ true };
+#else
+	/// @brief Whether compressed terms can be decoded, set by defining CPP_ETFER_ZLIB before including CppEtfer and linking zlib.
+	constexpr bool zlibEnabled{ false };
+#endif
+
+	/// @brief The largest uncompressed size that a compressed term may declare, so that a corrupt or hostile size cannot exhaust memory.
+	constexpr uint64_t maxInflatedTermSize{ 256ull * 1024ull * 1024ull };
+
+	/// @brief Inflate the zlib data of a compressed term, which must produce exactly the declared number of bytes.
+	/// @param data Pointer to the zlib data.
+	/// @param length The number of bytes of zlib data.
+	/// @param out Pointer to the storage for the uncompressed term.
+	/// @param outLength The declared uncompressed size.
+	inline void inflateTerm([[maybe_unused]] const uint8_t* data, [[maybe_unused]] uint64_t length, [[maybe_unused]] uint8_t* out,
+		[[maybe_unused]] uint64_t outLength) {
+#if defined(CPP_ETFER_ZLIB)
+		if (length > UINT_MAX || outLength > UINT_MAX) {
+			throw std::runtime_error{ "inflateTerm() Error: Compressed terms are limited to 4 GiB." };
+		}
+		z_stream stream{};
+		if (inflateInit(&stream) != Z_OK) {
+			throw std::runtime_error{ "inflateTerm() Error: Failed to initialize zlib." };
+		}
+		stream.next_in	 = const_cast<Bytef*>(data);
+		stream.avail_in	 = static_cast<uInt>(length);
+		stream.next_out	 = out;
+		stream.avail_out = static_cast<uInt>(outLength);
+		const int result = inflate(&stream, Z_FINISH);
+		const uint64_t produced{ stream.total_out };
+		inflateEnd(&stream);
+		if (result != Z_STREAM_END || produced != outLength) {
+			throw std::runtime_error{ "inflateTerm() Error: The compressed term is corrupt, or does not inflate to its declared size of " + std::to_string(outLength) + " bytes." };
+		}
+#else
+		throw std::runtime_error{ "inflateTerm() Error: Compressed terms require zlib, define CPP_ETFER_ZLIB and link zlib, or configure with -DZLIB=ON." };
+#endif
+	}
+
+}
@@ -0,0 +1,170 @@
+/*
+	MIT License
+
+	Copyright 2023 Chris M. (RealTimeChris)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+/// Oct 16, 2026
+/// https://github.com/RealTimeChris/CppEtfer
+/// \file ZlibStream.hpp
+
+#pragma once
+
+#include <CppEtfer/StreamParser.hpp>
+
+#include <zlib.h>
+
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <span>
+
+namespace CppEtfer {
+
+	/// @brief The default size of the window that an etf_zlib_stream_parser inflates into.
+	constexpr uint64_t defaultInflateWindowSize{ 64 * 1024 };
+
+	/// @brief Class for parsing a zlib-stream transport, such as Discord's compress=zlib-stream, to JSON.
+	/// One zlib context spans the whole connection, and each message is one ETF term. Compressed chunks are inflated into a fixed window,
+	/// and each fill of the window is fed straight to an etf_stream_parser, so a message is never held whole in uncompressed form. A chunk
+	/// may finish any number of messages, and may also begin the next one. The window, the zlib context and the JSON buffer are reused, so
+	/// once the JSON buffer has grown to fit, parsing a message does not allocate. Requires zlib to be linked.
+	class etf_zlib_stream_parser {
+	  public:
+		/// @brief Constructor that sets the size of the inflate window, whether strings are validated as UTF-8, and the nesting limit.
+		/// @param windowSize The number of uncompressed bytes to inflate before feeding them to the parser.
+		/// @param checkUtf8 Whether to throw on strings that are not well-formed UTF-8.
+		/// @param maxDepth The limit on how deeply lists and maps may be nested.
+		inline explicit etf_zlib_stream_parser(uint64_t windowSize = defaultInflateWindowSize, bool checkUtf8 = false, uint64_t maxDepth = defaultMaxDepth)
+			: parser{ checkUtf8, maxDepth } {
+			if (windowSize == 0 || windowSize > UINT_MAX) {
+				throw std::invalid_argument{ "etf_zlib_stream_parser::etf_zlib_stream_parser() Error: The window size must be between 1 byte and 4 GiB." };
+			}
+			window.resize(windowSize);
+			if (inflateInit(&stream) != Z_OK) {
+				throw std::runtime_error{ "etf_zlib_stream_parser::etf_zlib_stream_parser() Error: Failed to initialize zlib." };
+			}
+		}
+
+		etf_zlib_stream_parser(const etf_zlib_stream_parser&)			 = delete;
+		etf_zlib_stream_parser& operator=(const etf_zlib_stream_parser&) = delete;
+
+		inline ~etf_zlib_stream_parser() {
+			inflateEnd(&stream);
+		}
+
+		/// @brief Inflate and parse the next chunk of the stream.
+		/// @param chunk The next compressed bytes, typically the payload of one WebSocket frame.
+		/// @return The JSON of every message that this chunk finished, in order, valid until the next call to feed() or reset().
+		template<string_t string_type> inline std::span<const std::string_view> feed(string_type&& chunk) {
+			return feed(std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size() });
+		}
+
+		/// @brief Inflate and parse the next chunk of the stream.
+		/// @param chunk The next compressed bytes, typically the payload of one WebSocket frame.
+		/// @return The JSON of every message that this chunk finished, in order, valid until the next call to feed() or reset().
+		inline std::span<const std::string_view> feed(std::span<const uint8_t> chunk) {
+			if (chunk.size() > UINT_MAX) {
+				throw std::runtime_error{ "etf_zlib_stream_parser::feed() Error: Chunks are limited to 4 GiB." };
+			}
+			discardFinishedMessages();
+			stream.next_in	= const_cast<Bytef*>(chunk.data());
+			stream.avail_in = static_cast<uInt>(chunk.size());
+			do {
+				stream.next_out	 = window.data();
+				stream.avail_out = static_cast<uInt>(window.size());
+				const int result = inflate(&stream, Z_SYNC_FLUSH);
+				if (result != Z_OK && result != Z_BUF_ERROR && result != Z_STREAM_END) {
+					throw std::runtime_error{ "etf_zlib_stream_parser::feed() Error: Failed to inflate the stream: " + std::string{ stream.msg ? stream.msg : "unknown error" } +
+						"." };
+				}
+				const uint64_t produced = window.size() - stream.avail_out;
+				for (uint64_t offset = 0; offset < produced;) {
+					uint64_t consumed{};
+					const std::string_view newJson = parser.feed(std::span<const uint8_t>{ window.data() + offset, produced - offset }, consumed);
+					json.append(newJson.data(), newJson.size());
+					offset += consumed;
+					partial = true;
+					if (parser.done()) {
+						messageEnds.emplace_back(json.size());
+						parser.reset();
+						partial = false;
+					}
+				}
+				if (result == Z_STREAM_END) {
+					inflateReset(&stream);
+				} else if (result == Z_BUF_ERROR && produced == 0) {
+					break;
+				}
+			} while (stream.avail_out == 0 || stream.avail_in > 0);
+			messages.clear();
+			uint64_t messageStart{};
+			for (const uint64_t messageEnd: messageEnds) {
+				messages.emplace_back(json.data() + messageStart, messageEnd - messageStart);
+				messageStart = messageEnd;
+			}
+			return std::span<const std::string_view>{ messages.data(), messages.size() };
+		}
+
+		/// @brief Check whether every message fed so far has been parsed completely.
+		/// @return True if no message is partway through, false if more chunks are expected.
+		inline bool done() const {
+			return !partial;
+		}
+
+		/// @brief Start over with a new zlib context, as when reconnecting, discarding any partially parsed message.
+		inline void reset() {
+			inflateReset(&stream);
+			parser.reset();
+			json.clear();
+			messageEnds.clear();
+			messages.clear();
+			partial = false;
+		}
+
+	  protected:
+		z_stream stream{};///< The zlib context, which spans the whole connection.
+		etf_stream_parser parser{};///< The parser that each fill of the window is fed to.
+		uninitialized_buffer<uint8_t> window{};///< The window that chunks are inflated into.
+		uninitialized_buffer<char> json{};///< The JSON of the messages finished by the last chunk, followed by that of the message in progress.
+		std::vector<uint64_t> messageEnds{};///< The offsets in json at which the messages finished by the last chunk end.
+		std::vector<std::string_view> messages{};///< The JSON of the messages finished by the last chunk.
+		bool partial{};///< Whether a message is partway through.
+
+		/// @brief Drop the JSON of the messages that the last chunk finished, keeping that of the message in progress.
+		inline void discardFinishedMessages() {
+			if (messageEnds.empty()) {
+				return;
+			}
+			const uint64_t keptStart = messageEnds.back();
+			const uint64_t keptSize	 = json.size() - keptStart;
+			if (keptSize > 0) {
+				std::memmove(json.data(), json.data() + keptStart, keptSize);
+			}
+			json.resize(keptSize);
+			messageEnds.clear();
+		}
+	};
+
+}
@@ -2,8 +2,20 @@
 //
 
 #include <CppEtfer/CppEtfer.hpp>
+#include <CppEtfer/Document.hpp>
+#include <CppEtfer/Constant.hpp>
+#include <CppEtfer/Template.hpp>
+#include <CppEtfer/Transcoder.hpp>
+#include <CppEtfer/Filter.hpp>
+#include <CppEtfer/BatchSerializer.hpp>
+#include <CppEtfer/StreamParser.hpp>
+#if defined(CPP_ETFER_ZLIB)
+	#include <CppEtfer/ZlibStream.hpp>
+#endif
 #include <jsonifier/Index.hpp>
 #include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
 #include <iostream>
 #include <map>
 
@@ -75,6 +87,35 @@ template<> struct jsonifier::core<ReadyData> {
 	static constexpr auto parseValue = createObject("t", &ValueType::t, "s", &ValueType::s, "op", &ValueType::op, "d", &ValueType::d);
 };
 
+template<> struct CppEtfer::core<User> {
+	using value_type				 = User;
+	static constexpr auto parseValue = createObject("verified", &value_type::verified, "username", &value_type::username, "mfa_enabled", &value_type::mfa_enabled, "id",
+		&value_type::id, "global_name", &value_type::global_name, "flags", &value_type::flags, "email", &value_type::email, "discriminator", &value_type::discriminator, "bot",
+		&value_type::bot, "avatar", &value_type::avatar);
+};
+
+template<> struct CppEtfer::core<Guild> {
+	using value_type				 = Guild;
+	static constexpr auto parseValue = createObject("unavailable", &value_type::unavailable, "id", &value_type::id);
+};
+
+template<> struct CppEtfer::core<Session> {
+	using value_type				 = Session;
+	static constexpr auto parseValue = createObject("session_type", &value_type::session_type, "session_id", &value_type::session_id, "resume_gateway_url",
+		&value_type::resume_gateway_url, "guilds", &value_type::guilds);
+};
+
+template<> struct CppEtfer::core<Data> {
+	using value_type				 = Data;
+	static constexpr auto parseValue = createObject("session", &value_type::session, "v", &value_type::v, "user", &value_type::user, "shard", &value_type::shard,
+		"user_settings", &value_type::user_settings);
+};
+
+template<> struct CppEtfer::core<ReadyData> {
+	using value_type				 = ReadyData;
+	static constexpr auto parseValue = createObject("t", &value_type::t, "s", &value_type::s, "op", &value_type::op, "d", &value_type::d);
+};
+
 /// @brief Activity types.
 enum class ActivityType : uint8_t {
 	Game	  = 0,///< Game.
@@ -165,6 +206,30 @@ struct UpdatePresenceData {
 	
 };
 
+bool testsPassed{ true };
+
+void checkResult(std::string_view name, bool passed) {
+	std::cout << name << (passed ? ": passed" : ": FAILED") << std::endl;
+	testsPassed = testsPassed && passed;
+}
+
+void checkJson(std::string_view name, std::string_view json, std::string_view expected) {
+	if (json != expected) {
+		std::cout << name << ": expected " << expected << ", got " << json << std::endl;
+	}
+	checkResult(name, json == expected);
+}
+
+template<typename function_type> void checkThrows(std::string_view name, std::string_view message, function_type&& function) {
+	bool threw{};
+	try {
+		function();
+	} catch (const std::exception& error) {
+		threw = std::string_view{ error.what() }.find(message) != std::string_view::npos;
+	}
+	checkResult(name, threw);
+}
+
 int main()
 {
 	std::vector<uint8_t> stringValues = { 131, 116, 0, 0, 0, 4, 100, 0, 1, 100, 116, 0, 0, 0, 16, 100, 0, 6, 95, 116, 114, 97, 99, 101, 108, 0, 0, 0, 1, 109, 0, 0, 3, 196, 91, 34, 103,
@@ -248,5 +313,368 @@ int main()
 	auto newData02 = parser02.parseEtfToJson(newString);
 
 	std::cout << "Json data: " << newData02 << std::endl;
-	return 0;
+
+	ReadyData readyData{};
+	CppEtfer::etf_parser parser03{};
+	parser03.parseEtfToData(readyData, presenceUpdateString);
+	std::cout << "Parsed data: " << readyData.t << ", " << readyData.d.user.username << ", shard: [" << readyData.d.shard[0] << "," << readyData.d.shard[1] << "]" << std::endl;
+
+	std::basic_string<uint8_t> readyString{};
+	CppEtfer::etf_serializer::serializeToEtf(readyData, readyString);
+	CppEtfer::etf_parser parser04{};
+	std::cout << "Json data: " << parser04.parseEtfToJson(readyString) << std::endl;
+
+	CppEtfer::etf_document document{};
+	document.parse(presenceUpdateString);
+	checkResult("Document lookup", document["t"].getString() == "READY" && document["d"]["user"]["username"].getString() == "MBot-MusicHouse-2");
+
+	CppEtfer::etf_serializer guildTree{};
+	guildTree["id"] = 5;
+	guildTree["name"] = "Guild";
+	guildTree["shard"].emplaceBack(0);
+	guildTree["shard"].emplaceBack(1);
+	guildTree["shard"].emplaceBack(2);
+	guildTree["large"] = true;
+	CppEtfer::etf_document guildDocument{};
+	auto guild = guildDocument.parse(guildTree.operator std::basic_string<uint8_t>());
+	std::vector<int64_t> shardValues{};
+	for (auto shard: guild["shard"]) {
+		shardValues.emplace_back(shard.get<int64_t>());
+	}
+	checkResult("Document iteration", shardValues == std::vector<int64_t>{ 0, 1, 2 } && guild["shard"].size() == 3);
+	checkResult("Document index", guild["shard"][1].get<int64_t>() == 1 && guild["shard"][2].get<int64_t>() == 2);
+	checkResult("Document typed get", guild["id"].get<int64_t>() == 5 && guild["name"].get<std::string>() == "Guild" && guild["large"].get<bool>());
+	checkResult("Document contains", guild.contains("name") && !guild.contains("owner"));
+	checkThrows("Document missing key", "Key not found", [&] {
+		guild["owner"];
+	});
+	checkThrows("Document index past end", "Index out of range", [&] {
+		guild["shard"][3];
+	});
+	checkJson("Document value JSON", guild["shard"].toJson(), "[0,1,2]");
+	checkJson("Document JSON", guild.toJson(), "{\"id\":5,\"name\":\"Guild\",\"shard\":[0,1,2],\"large\":true}");
+
+	CppEtfer::etf_parser parser05{};
+	auto envelope = parser05.parseEnvelope(presenceUpdateString);
+	checkResult("Envelope fields", envelope.op == 0 && envelope.s == 1 && envelope.t == "READY");
+	const std::string envelopeJson{ parser05.parseValueToJson(envelope.d) };
+	CppEtfer::etf_parser envelopeParser{};
+	checkResult("Envelope data", envelopeParser.parseEtfToJson(presenceUpdateString).find("\"d\":" + envelopeJson + ",") != std::string_view::npos);
+	static constexpr uint8_t heartbeatAck[]{ 131, 116, 0, 0, 0, 4, 119, 2, 'o', 'p', 97, 11, 119, 1, 'd', 119, 3, 'n', 'i', 'l', 119, 1, 's', 119, 3, 'n', 'i', 'l', 119, 1,
+		't', 119, 3, 'n', 'i', 'l' };
+	const auto ackEnvelope = parser05.parseEnvelope(std::span<const uint8_t>{ heartbeatAck });
+	checkResult("Envelope heartbeat ACK", ackEnvelope.op == 11 && !ackEnvelope.s.has_value() && ackEnvelope.t.empty());
+
+	static constexpr auto identifyProperties = CppEtfer::etfConstant([] {
+		return CppEtfer::etfMap("op", 2, "d", CppEtfer::etfMap("intents", 513, "shard", CppEtfer::etfList(0, 1), "properties", CppEtfer::etfMap("os", "linux", "browser", "CppEtfer")));
+	});
+	CppEtfer::etf_parser parser06{};
+	checkJson("Constant data", parser06.parseEtfToJson(std::span<const uint8_t>{ identifyProperties }),
+		"{\"op\":2,\"d\":{\"intents\":513,\"shard\":[0,1],\"properties\":{\"os\":\"linux\",\"browser\":\"CppEtfer\"}}}");
+	CppEtfer::etf_serializer identifyTree{};
+	identifyTree["op"] = 2;
+	identifyTree["d"]["intents"] = 513;
+	identifyTree["d"]["shard"].emplaceBack(0);
+	identifyTree["d"]["shard"].emplaceBack(1);
+	identifyTree["d"]["properties"]["os"] = "linux";
+	identifyTree["d"]["properties"]["browser"] = "CppEtfer";
+	const std::basic_string<uint8_t> identifyBytes = identifyTree;
+	checkResult("Constant bytes", std::ranges::equal(identifyBytes, std::span<const uint8_t>{ identifyProperties }));
+
+	std::basic_string<uint8_t> identifySpan(identifyTree.serializedSize(), 0);
+	checkResult("Serialize to exact span", identifyTree.serializeTo(identifySpan) == identifyBytes.size() && identifySpan == identifyBytes);
+	checkThrows("Serialize to short span", "are needed", [&] {
+		identifyTree.serializeTo(std::span<uint8_t>{ identifySpan.data(), identifySpan.size() - 1 });
+	});
+	const auto identifyBuffer = identifyTree.serializeToBuffer();
+	checkResult("Serialize to buffer", std::ranges::equal(identifyBuffer, identifyBytes));
+	const auto identifyBufferAgain = identifyTree.serializeToBuffer();
+	checkResult("Serialize to buffer reuse", identifyBufferAgain.data() == identifyBuffer.data() && std::ranges::equal(identifyBufferAgain, identifyBytes));
+
+	CppEtfer::etf_template heartbeat{ CppEtfer::etfMap("op", 1, "d", CppEtfer::etfIntegerSlot()) };
+	heartbeat.set(0, envelope.s.value_or(0));
+	checkJson("Template integer slot", parser06.parseEtfToJson(heartbeat.data()), "{\"op\":1,\"d\":\"1\"}");
+
+	CppEtfer::etf_template presence{ CppEtfer::etfMap("status", CppEtfer::etfStringSlot(8, "idle"), "afk", CppEtfer::etfBoolSlot(true), "since",
+		CppEtfer::etfIntegerSlot(), "game", CppEtfer::etfStringSlot(16)) };
+	const uint8_t* presenceStorage = presence.data().data();
+	checkJson("Template initial", parser06.parseEtfToJson(presence.data()), "{\"status\":\"idle\",\"afk\":true,\"since\":\"0\",\"game\":\"\"}");
+	presence.set(0, "online");
+	presence.set(1, false);
+	presence.set(2, int64_t{ -1700000000000 });
+	presence.set(3, std::string{ "Test_Activity_01" });
+	checkJson("Template set", parser06.parseEtfToJson(presence.data()), "{\"status\":\"online\",\"afk\":false,\"since\":\"-1700000000000\",\"game\":\"Test_Activity_01\"}");
+	presence.set(0, "");
+	presence.set(1, true);
+	checkJson("Template shrink", parser06.parseEtfToJson(presence.data()), "{\"status\":\"\",\"afk\":true,\"since\":\"-1700000000000\",\"game\":\"Test_Activity_01\"}");
+	checkResult("Template storage", presence.data().data() == presenceStorage);
+	checkThrows("Template capacity", "capacity", [&] {
+		presence.set(0, "Do_Not_Disturb");
+	});
+	checkThrows("Template slot type", "different type", [&] {
+		presence.set(1, 5);
+	});
+	checkThrows("Template slot index", "no slot", [&] {
+		presence.set(4, true);
+	});
+
+	std::basic_string<uint8_t> transcodedString{};
+	CppEtfer::transcodeJsonToEtf(std::string_view{ parser06.parseEtfToJson(presenceUpdateString) }, transcodedString);
+	std::cout << "Transcoded data: " << parser06.parseEtfToJson(transcodedString) << std::endl;
+
+	CppEtfer::etf_filter filter{ CppEtfer::etf_filter_mode::deny, { "d._trace", "d.guilds" } };
+	std::string filteredJson{ parser06.parseEtfToJson(filter.filter(transcodedString)) };
+	std::cout << "Filtered data: " << filteredJson << std::endl;
+	checkResult("Filter deny", filteredJson.find("\"_trace\"") == std::string::npos && filteredJson.find("\"guilds\"") == std::string::npos &&
+			filteredJson.find("\"guild_join_requests\":[]") != std::string::npos && filteredJson.find("\"session_id\":\"05e822b17e30bebea730f34839372d97\"") != std::string::npos);
+
+	CppEtfer::etf_filter nestedFilter{ CppEtfer::etf_filter_mode::deny, { "d._trace", "d.guilds.id" } };
+	std::string nestedJson{ parser06.parseEtfToJson(nestedFilter.filter(transcodedString)) };
+	checkResult("Filter deny nested", nestedJson.find("\"_trace\"") == std::string::npos &&
+			nestedJson.find("\"guilds\":[{\"unavailable\":true},{\"unavailable\":true},{\"unavailable\":true},{\"unavailable\":true},{\"unavailable\":true},{\"unavailable\":true},{"
+							"\"unavailable\":true}]") != std::string::npos);
+
+	CppEtfer::etf_filter allowFilter{ CppEtfer::etf_filter_mode::allow, { "op", "d.guilds.id" } };
+	checkJson("Filter allow", parser06.parseEtfToJson(allowFilter.filter(transcodedString)),
+		"{\"d\":{\"guilds\":[{\"id\":\"931640556814237706\"},{\"id\":\"991025447875784714\"},{\"id\":\"995048955215872071\"},{\"id\":\"1022405038922006538\"},{\"id\":"
+		"\"1032783776184533022\"},{\"id\":\"1078501504119476282\"},{\"id\":\"1131853763506880522\"}]},\"op\":0}");
+
+	CppEtfer::etf_batch_serializer batch{};
+	const auto fillBatch = [&] {
+		CppEtfer::etf_serializer heartbeatTree{};
+		heartbeatTree["op"] = 1;
+		heartbeatTree["d"]	= 251;
+		batch.add(heartbeatTree);
+		batch.add(Guild{ .unavailable = true, .id = "931640556814237706" });
+	};
+	const auto batchJson = [&] {
+		std::string json{};
+		for (const auto& entry: batch.table()) {
+			json += std::string{ parser06.parseEtfToJson(batch.data().subspan(entry.offset, entry.length)) } + ";";
+		}
+		return json;
+	};
+	fillBatch();
+	const uint8_t* batchStorage = batch.data().data();
+	checkJson("Batch serializer", batchJson(), "{\"op\":1,\"d\":251};{\"unavailable\":true,\"id\":\"931640556814237706\"};");
+	batch.clear();
+	checkResult("Batch serializer clear", batch.empty() && batch.data().empty());
+	fillBatch();
+	checkResult("Batch serializer reuse", batch.size() == 2 && batch.data().data() == batchStorage && batch.table()[1].offset == batch.table()[0].length);
+
+	std::basic_string<uint8_t> keyedString{};
+	CppEtfer::transcodeJsonToEtf(std::string_view{ "{\"known_key\":1,\"peer_key_5f3a\":2}" }, keyedString);
+	const CppEtfer::interned_key knownKey{ "known_key" };
+	std::unordered_map<CppEtfer::interned_key, int32_t> keyedMap{};
+	parser06.parseEtfToData(keyedMap, keyedString);
+	checkResult("Interned keys", keyedMap.size() == 1 && keyedMap[knownKey] == 1 && !CppEtfer::interned_key::find("peer_key_5f3a"));
+
+	static constexpr uint64_t testDepth{ 8 };
+	const auto nestedTerm = [](uint64_t depth) {
+		std::basic_string<uint8_t> term{ 131 };
+		for (uint64_t x = 0; x < depth; ++x) {
+			term.append({ 108, 0, 0, 0, 1 });
+		}
+		term.append({ 97, 1 });
+		term.append(depth, 106);
+		return term;
+	};
+	const auto nestedSerializer = [](uint64_t depth) {
+		CppEtfer::etf_serializer serializer{};
+		CppEtfer::etf_serializer* node{ &serializer };
+		for (uint64_t x = 1; x < depth; ++x) {
+			node = &(*node)["a"];
+		}
+		(*node)["a"] = 1;
+		return serializer;
+	};
+	const auto nestedArray = [](uint64_t depth) {
+		return std::string(depth, '[') + "1" + std::string(depth, ']');
+	};
+	CppEtfer::etf_parser depthParser{ false, testDepth };
+	checkJson("Parse at depth limit", depthParser.parseEtfToJson(nestedTerm(testDepth)), nestedArray(testDepth));
+	checkThrows("Parse past depth limit", "maximum nesting depth", [&] {
+		depthParser.parseEtfToJson(nestedTerm(testDepth + 1));
+	});
+	std::basic_string<uint8_t> depthBuffer{};
+	nestedSerializer(testDepth).serializeAppend(depthBuffer, testDepth);
+	checkResult("Serialize at depth limit", !depthBuffer.empty());
+	checkThrows("Serialize past depth limit", "maximum nesting depth", [&] {
+		nestedSerializer(testDepth + 1).serializeAppend(depthBuffer, testDepth);
+	});
+	CppEtfer::transcodeJsonToEtf(nestedArray(testDepth), depthBuffer, testDepth);
+	checkResult("Transcode at depth limit", depthBuffer == nestedTerm(testDepth));
+	checkThrows("Transcode past depth limit", "maximum nesting depth", [&] {
+		CppEtfer::transcodeJsonToEtf(nestedArray(testDepth + 1), depthBuffer, testDepth);
+	});
+
+	const auto checkTerm = [&](std::string_view name, const std::basic_string<uint8_t>& term, std::string_view expected) {
+		checkJson(name, parser06.parseEtfToJson(term), expected);
+		CppEtfer::etf_stream_parser streamParser{};
+		std::string streamJson{};
+		for (uint8_t value: term) {
+			streamJson += streamParser.feed(std::basic_string_view<uint8_t>{ &value, 1 });
+		}
+		checkJson(std::string{ name } + " (streamed)", streamParser.done() ? streamJson : "incomplete", expected);
+	};
+	checkTerm("Small tuple", { 131, 104, 3, 97, 1, 109, 0, 0, 0, 1, 'a', 119, 2, 'o', 'k' }, "[1,\"a\",\"ok\"]");
+	checkTerm("Large tuple", { 131, 105, 0, 0, 0, 2, 97, 1, 104, 0 }, "[1,[]]");
+	checkTerm("Improper list", { 131, 108, 0, 0, 0, 2, 97, 1, 97, 2, 97, 3 }, "[1,2,3]");
+	checkTerm("Small big over 8 bytes", { 131, 110, 9, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1 }, "\"-18446744073709551616\"");
+	checkTerm("Large big", { 131, 111, 0, 0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 }, "\"4722366482869645213696\"");
+	std::basic_string<uint8_t> floatTerm{ 131, 99 };
+	floatTerm.append(reinterpret_cast<const uint8_t*>("1.50000000000000000000e+00"), 26);
+	floatTerm.resize(33, 0);
+	checkTerm("Float", floatTerm, "1.5");
+	checkTerm("Bit binary", { 131, 77, 0, 0, 0, 2, 3, 'h', 'i' }, "\"hi\"");
+	checkTerm("Pid", { 131, 103, 119, 1, 'n', 0, 0, 0, 1, 0, 0, 0, 2, 3 }, "{\"node\":\"n\",\"id\":1,\"serial\":2,\"creation\":3}");
+	checkTerm("New pid", { 131, 88, 119, 1, 'n', 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 3 }, "{\"node\":\"n\",\"id\":1,\"serial\":2,\"creation\":3}");
+	checkTerm("New port", { 131, 89, 119, 1, 'n', 0, 0, 0, 5, 0, 0, 0, 6 }, "{\"node\":\"n\",\"id\":5,\"creation\":6}");
+	checkTerm("Newer reference", { 131, 90, 0, 2, 119, 1, 'n', 0, 0, 0, 1, 0, 0, 0, 7, 0, 0, 0, 8 }, "{\"node\":\"n\",\"creation\":1,\"id\":[7,8]}");
+	checkTerm("Export", { 131, 113, 119, 1, 'm', 119, 1, 'f', 97, 2 }, "{\"module\":\"m\",\"function\":\"f\",\"arity\":2}");
+	const std::basic_string<uint8_t> funTerm{ 131, 112, 0, 0, 0, 52, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 119, 1, 'm', 97, 0, 97,
+		0, 88, 119, 1, 'n', 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 3 };
+	checkTerm("New fun", funTerm, "{\"module\":\"m\",\"arity\":1}");
+	checkTerm("String", { 131, 107, 0, 2, 0, 1 }, "[0,1]");
+	std::basic_string<uint8_t> hugeBigTerm{ 131, 111, 0, 1, 0, 0, 0 };
+	hugeBigTerm.append(65536, 0xFF);
+	checkThrows("Oversized big integer", "more than the limit", [&] {
+		parser06.parseEtfToJson(hugeBigTerm);
+	});
+	checkThrows("Oversized big integer (streamed)", "more than the limit", [&] {
+		CppEtfer::etf_stream_parser streamParser{};
+		streamParser.feed(hugeBigTerm.substr(0, 4));
+		streamParser.feed(hugeBigTerm.substr(4, 4));
+	});
+	checkThrows("Oversized big integer (document)", "more than the limit", [&] {
+		CppEtfer::etf_document bigDocument{};
+		bigDocument.parse(hugeBigTerm);
+	});
+	checkThrows("Oversized big integer (data)", "more than the limit", [&] {
+		std::string bigString{};
+		parser06.parseEtfToData(bigString, hugeBigTerm);
+	});
+
+	struct value_size_probe : public CppEtfer::etf_parser {
+		using etf_parser::valueSize;
+	};
+	checkResult("Value size", value_size_probe::valueSize(funTerm.data() + 1, funTerm.size() - 1) == funTerm.size() - 1 &&
+			value_size_probe::valueSize(floatTerm.data() + 1, floatTerm.size() - 1) == 32 && value_size_probe::valueSize(std::basic_string<uint8_t>{ 109, 0, 0 }.data(), 3) == 5 &&
+			value_size_probe::valueSize(std::basic_string<uint8_t>{ 109, 0, 0, 1, 0 }.data(), 5) == 261 &&
+			value_size_probe::valueSize(std::basic_string<uint8_t>{ 90, 0, 2, 119, 1, 'n' }.data(), 6) == 18);
+
+#if defined(CPP_ETFER_ZLIB)
+	z_stream deflater{};
+	deflateInit(&deflater, Z_DEFAULT_COMPRESSION);
+	std::basic_string<uint8_t> compressedString(deflateBound(&deflater, presenceUpdateString.size()), 0);
+	deflater.next_in   = presenceUpdateString.data();
+	deflater.avail_in  = static_cast<uInt>(presenceUpdateString.size());
+	deflater.next_out  = compressedString.data();
+	deflater.avail_out = static_cast<uInt>(compressedString.size());
+	deflate(&deflater, Z_SYNC_FLUSH);
+	compressedString.resize(compressedString.size() - deflater.avail_out);
+	deflateEnd(&deflater);
+	CppEtfer::etf_zlib_stream_parser zlibStreamParser{};
+	std::string inflatedJson{};
+	for (uint64_t x = 0; x < compressedString.size(); x += 64) {
+		for (std::string_view message: zlibStreamParser.feed(std::basic_string_view<uint8_t>{ compressedString }.substr(x, 64))) {
+			inflatedJson = message;
+		}
+	}
+	checkJson("Zlib stream", zlibStreamParser.done() ? inflatedJson : "incomplete", parser.parseEtfToJson(presenceUpdateString));
+
+	const auto deflateMessages = [](std::initializer_list<std::basic_string<uint8_t>> messages) {
+		z_stream messageDeflater{};
+		deflateInit(&messageDeflater, Z_DEFAULT_COMPRESSION);
+		std::basic_string<uint8_t> deflated{};
+		for (auto& message: messages) {
+			std::basic_string<uint8_t> block(deflateBound(&messageDeflater, message.size()) + 16, 0);
+			messageDeflater.next_in	  = const_cast<uint8_t*>(message.data());
+			messageDeflater.avail_in  = static_cast<uInt>(message.size());
+			messageDeflater.next_out  = block.data();
+			messageDeflater.avail_out = static_cast<uInt>(block.size());
+			deflate(&messageDeflater, Z_SYNC_FLUSH);
+			deflated.append(block.data(), block.size() - messageDeflater.avail_out);
+		}
+		deflateEnd(&messageDeflater);
+		return deflated;
+	};
+	const auto joinMessages = [](std::span<const std::string_view> messages) {
+		std::string joined{};
+		for (std::string_view message: messages) {
+			joined += std::string{ message } + ";";
+		}
+		return joined;
+	};
+	const std::basic_string<uint8_t> twoMessages = deflateMessages({ { 131, 97, 1 }, { 131, 97, 2 } });
+	CppEtfer::etf_zlib_stream_parser multiParser{};
+	checkJson("Zlib stream two messages in one chunk", joinMessages(multiParser.feed(twoMessages)), "1;2;");
+	CppEtfer::etf_zlib_stream_parser narrowParser{ 2 };
+	checkJson("Zlib stream two messages across window fills", joinMessages(narrowParser.feed(twoMessages)), "1;2;");
+	const std::basic_string<uint8_t> splitMessages = deflateMessages({ { 131, 104, 2, 97, 1 }, { 97, 2, 131, 104, 2, 97, 3 }, { 97, 4 } });
+	std::string splitJson{};
+	multiParser.reset();
+	for (uint64_t x = 0; x < splitMessages.size(); ++x) {
+		splitJson += joinMessages(multiParser.feed(splitMessages.substr(x, 1)));
+	}
+	checkJson("Zlib stream messages split across chunks", multiParser.done() ? splitJson : "incomplete", "[1,2];[3,4];");
+
+	const uint32_t termSize = static_cast<uint32_t>(presenceUpdateString.size() - 1);
+	uLongf termBodySize		= compressBound(termSize);
+	std::basic_string<uint8_t> compressedTerm{ 131, 80, static_cast<uint8_t>(termSize >> 24), static_cast<uint8_t>(termSize >> 16), static_cast<uint8_t>(termSize >> 8),
+		static_cast<uint8_t>(termSize) };
+	compressedTerm.resize(compressedTerm.size() + termBodySize);
+	compress(compressedTerm.data() + 6, &termBodySize, presenceUpdateString.data() + 1, termSize);
+	compressedTerm.resize(6 + termBodySize);
+	checkJson("Compressed term", parser06.parseEtfToJson(compressedTerm), std::string{ parser.parseEtfToJson(presenceUpdateString) });
+	auto compressedEnvelope = parser05.parseEnvelope(compressedTerm);
+	checkResult("Compressed envelope", compressedEnvelope.op == envelope.op && compressedEnvelope.s == envelope.s && compressedEnvelope.t == envelope.t &&
+			std::ranges::equal(compressedEnvelope.d, envelope.d));
+	std::string compressedFiltered{ parser06.parseEtfToJson(filter.filter(compressedTerm)) };
+	checkJson("Compressed filter", compressedFiltered, parser06.parseEtfToJson(filter.filter(presenceUpdateString)));
+
+	CppEtfer::etf_stream_parser compressedStreamParser{};
+	std::string compressedStreamJson{};
+	for (uint8_t value: compressedTerm) {
+		compressedStreamJson += compressedStreamParser.feed(std::basic_string_view<uint8_t>{ &value, 1 });
+	}
+	checkJson("Compressed stream", compressedStreamParser.done() ? compressedStreamJson : "incomplete", parser.parseEtfToJson(presenceUpdateString));
+
+	compressedTerm[5] += 1;
+	checkThrows("Compressed size mismatch", "declared size", [&] {
+		parser06.parseEtfToJson(compressedTerm);
+	});
+	checkThrows("Compressed stream size mismatch", "declared size", [&] {
+		compressedStreamParser.reset();
+		compressedStreamParser.feed(compressedTerm);
+	});
+#endif
+
+#if defined(CPP_ETFER_INSTRUMENTATION)
+	static CppEtfer::etf_frame_record lastFrame{};
+	static uint64_t callbackCount{};
+	auto& metrics = CppEtfer::etf_metrics::global();
+	metrics.setFrameCallback([](const CppEtfer::etf_frame_record& record) {
+		lastFrame = record;
+		++callbackCount;
+	});
+	static constexpr uint8_t metricsTerm[]{ 131, 116, 0, 0, 0, 1, 119, 1, 'a', 108, 0, 0, 0, 2, 97, 1, 97, 2, 106 };
+	const auto tagCount = [](const CppEtfer::etf_metrics_snapshot& snapshot, CppEtfer::etf_type type) {
+		return snapshot.parserTags[static_cast<uint8_t>(type)].count;
+	};
+	const auto metricsBefore = metrics.snapshot();
+	CppEtfer::etf_parser metricsParser{};
+	checkJson("Metrics frame", metricsParser.parseEtfToJson(std::span<const uint8_t>{ metricsTerm }), "{\"a\":[1,2]}");
+	const auto metricsAfter = metrics.snapshot();
+	metrics.setFrameCallback(nullptr);
+	checkResult("Metrics frame count",
+		metricsAfter[CppEtfer::etf_frame_kind::parse_json].count == metricsBefore[CppEtfer::etf_frame_kind::parse_json].count + 1 &&
+			metricsAfter[CppEtfer::etf_frame_kind::parse_json].bytesIn == metricsBefore[CppEtfer::etf_frame_kind::parse_json].bytesIn + std::size(metricsTerm));
+	checkResult("Metrics tag counts",
+		tagCount(metricsAfter, CppEtfer::etf_type::Map_Ext) == tagCount(metricsBefore, CppEtfer::etf_type::Map_Ext) + 1 &&
+			tagCount(metricsAfter, CppEtfer::etf_type::List_Ext) == tagCount(metricsBefore, CppEtfer::etf_type::List_Ext) + 1 &&
+			tagCount(metricsAfter, CppEtfer::etf_type::Small_Integer_Ext) == tagCount(metricsBefore, CppEtfer::etf_type::Small_Integer_Ext) + 2);
+	checkResult("Metrics callback", callbackCount == 1 && lastFrame.kind == CppEtfer::etf_frame_kind::parse_json && lastFrame.bytesIn == std::size(metricsTerm));
+#endif
+	return testsPassed ? 0 : 1;
 }